@@ -1,5 +1,7 @@
 #include "Area.hpp"
 #include "Console.hpp"
+#include "Pathfinder.hpp"
+#include "Trace.hpp"
 
 namespace AStar {
     Area::Area() noexcept = default;
@@ -37,6 +39,7 @@ namespace AStar {
     }
 
     auto Area::Render() const noexcept -> void {
+        const TraceScope trace("Area::Render");
 
         // Draw top border
         Console::Write(L"╭");
@@ -119,11 +122,43 @@ namespace AStar {
         }
     }
 
-    auto Area::DrawPath(std::stack<Vector2>& path) noexcept -> void {
+    auto Area::DrawSearch(const Pathfinder& pathfinder) noexcept -> void {
+        constexpr Tile obstacle = { L'x', Console::Color::ForegroundBrightRed };
+        constexpr Tile open = { L'o', Console::Color::ForegroundBrightCyan };
+        constexpr Tile closed = { L'0', Console::Color::ForegroundBrightMagenta };
+
+        Clear();
+
+        for (short y = 0; y < _height; ++y) {
+            for (short x = 0; x < _width; ++x) {
+                if (!pathfinder.GetGrid().GetPassability().IsPassable({ x, y })) {
+                    Set({ x, y }, obstacle);
+                    continue;
+                }
+
+                switch (pathfinder.GetTileState({ x, y })) {
+                case Pathfinder::TileState::Open:
+                    Set({ x, y }, open);
+                    break;
+
+                case Pathfinder::TileState::Closed:
+                    Set({ x, y }, closed);
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        Set(pathfinder.GetStart(), { L'S', Console::Color::ForegroundBrightGreen });
+        Set(pathfinder.GetEnd(), { L'E', Console::Color::ForegroundBrightYellow });
+    }
+
+    auto Area::DrawPath(const std::span<const Vector2> path) noexcept -> void {
         // Set the tile symbols and then render
-        while (!path.empty()) {
-            Set(path.top(), { L'█', Console::Color::ForegroundBrightGreen });
-            path.pop();
+        for (const Vector2& tile : path) {
+            Set(tile, { L'█', Console::Color::ForegroundBrightGreen });
         }
 
         Render();
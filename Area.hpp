@@ -1,9 +1,11 @@
 #pragma once
 #include "Console.hpp"
-#include "Windows.hpp"
-#include <stack>
+#include "Vector2.hpp"
+#include <span>
 
 namespace AStar {
+    class Pathfinder;
+
     // Helper struct for character information
     struct Tile {
         wchar_t character;
@@ -29,8 +31,11 @@ namespace AStar {
         // Renders the area to the buffer
         auto Render() const noexcept -> void;
 
+        // Fills the area with the obstacles and search state of the pathfinder
+        auto DrawSearch(const Pathfinder& pathfinder) noexcept -> void;
+
         // Draws the path
-        auto DrawPath(std::stack<Vector2>& path) noexcept -> void;
+        auto DrawPath(std::span<const Vector2> path) noexcept -> void;
 
         // Clears the area
         auto Clear() noexcept -> void;
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace AStar {
+    // Divides rounding towards negative infinity, for a positive divisor
+    inline auto FloorDivide(const long long value, const long long divisor) noexcept -> long long {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+} // namespace AStar
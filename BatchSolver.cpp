@@ -0,0 +1,220 @@
+#include "BatchSolver.hpp"
+#include <algorithm>
+
+namespace AStar {
+    BatchSolver::BatchSolver(std::shared_ptr<const Grid> grid, const SearchOptions& options, const unsigned int threadCount) noexcept
+    : _grid(std::move(grid)) {
+        const unsigned int count = std::max(threadCount == 0 ? std::thread::hardware_concurrency() : threadCount, 1u);
+
+        // JPS+ tables are shared instead of every context building its own
+        if (options.expansion == Expansion::JumpPointPlus) {
+            _jumpTable = std::make_shared<const JumpTable>(_grid->GetPassability());
+        }
+
+        // Suspended searches hold on to their context, so their number is capped by the spares.
+        // A query that finds no spare context runs to completion on its worker's own.
+        _contexts.reserve(count * 2);
+
+        for (unsigned int i = 0; i < count * 2; ++i) {
+            _contexts.emplace_back(_grid, options);
+            _contexts.back().SetJumpTable(_jumpTable);
+        }
+
+        for (unsigned int i = count; i < count * 2; ++i) {
+            _spareContexts.push_back(&_contexts[i]);
+        }
+
+        _queues = std::vector<TaskQueue>(count);
+        _workers.reserve(count);
+
+        for (unsigned int i = 0; i < count; ++i) {
+            _workers.emplace_back([this, i] { Work(i); });
+        }
+    }
+
+    BatchSolver::~BatchSolver() noexcept {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+
+        _batchReady.notify_all();
+        _workers.clear();
+    }
+
+    auto BatchSolver::ThreadCount() const noexcept -> unsigned int {
+        return static_cast<unsigned int>(_workers.size());
+    }
+
+    auto BatchSolver::SetTimeSlice(const std::chrono::nanoseconds slice) noexcept -> void {
+        // Workers only read the slice during a batch
+        std::lock_guard solving(_solveMutex);
+        _timeSlice = slice;
+    }
+
+    auto BatchSolver::SetLandmarks(std::shared_ptr<const LandmarkTable> table) noexcept -> void {
+        // Contexts are only touched by workers during a batch
+        std::lock_guard solving(_solveMutex);
+
+        for (Pathfinder& context : _contexts) {
+            context.SetLandmarks(table);
+        }
+    }
+
+    auto BatchSolver::Solve(const std::span<const PathQuery> queries) noexcept -> std::vector<Pathfinder::Result> {
+        std::vector<Pathfinder::Result> results(queries.size());
+
+        // One batch at a time, the workers only know about the current one
+        std::lock_guard solving(_solveMutex);
+
+        // Deal the queries out in contiguous runs, stealing evens out whatever the runs cost
+        const std::size_t threads = _queues.size();
+
+        for (std::size_t worker = 0; worker < threads; ++worker) {
+            const std::size_t begin = queries.size() * worker / threads;
+            const std::size_t end = queries.size() * (worker + 1) / threads;
+
+            std::lock_guard queueLock(_queues[worker].mutex);
+
+            for (std::size_t i = begin; i < end; ++i) {
+                _queues[worker].tasks.push_back({ i, nullptr });
+            }
+        }
+
+        std::unique_lock lock(_mutex);
+        _queries = queries;
+        _results = &results;
+        _remaining = queries.size();
+        _pending = ThreadCount();
+        ++_batch;
+
+        _batchReady.notify_all();
+        _batchDone.wait(lock, [this] { return _pending == 0; });
+
+        _results = nullptr;
+        return results;
+    }
+
+    auto BatchSolver::Work(const unsigned int worker) noexcept -> void {
+        std::size_t seenBatch = 0;
+
+        while (true) {
+            {
+                std::unique_lock lock(_mutex);
+                _batchReady.wait(lock, [&] { return _stopping || _batch != seenBatch; });
+
+                if (_stopping) {
+                    return;
+                }
+
+                seenBatch = _batch;
+            }
+
+            // Queries still in flight on other workers may yet be suspended and become stealable
+            while (_remaining.load(std::memory_order_acquire) > 0) {
+                // Read before the queues are searched, so a task queued after the search changes the count
+                const std::size_t requeued = _requeued.load(std::memory_order_acquire);
+                Task task;
+
+                if (!NextTask(worker, task)) {
+                    std::unique_lock lock(_mutex);
+                    _taskQueued.wait(lock, [&] {
+                        return _requeued.load(std::memory_order_relaxed) != requeued || _remaining.load(std::memory_order_acquire) == 0;
+                    });
+                    continue;
+                }
+
+                if (RunTask(worker, task)) {
+                    if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        std::lock_guard lock(_mutex);
+                        _taskQueued.notify_all();
+                    }
+
+                    continue;
+                }
+
+                // Suspended searches go to the stealing end, so an idle worker picks them up
+                // while this one carries on with the queries behind them
+                {
+                    std::lock_guard queueLock(_queues[worker].mutex);
+                    _queues[worker].tasks.push_front(task);
+                }
+
+                std::lock_guard lock(_mutex);
+                _requeued.fetch_add(1, std::memory_order_release);
+                _taskQueued.notify_one();
+            }
+
+            {
+                std::lock_guard lock(_mutex);
+
+                if (--_pending == 0) {
+                    _batchDone.notify_one();
+                }
+            }
+        }
+    }
+
+    auto BatchSolver::NextTask(const unsigned int worker, Task& task) noexcept -> bool {
+        {
+            TaskQueue& own = _queues[worker];
+            std::lock_guard lock(own.mutex);
+
+            if (!own.tasks.empty()) {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        // Visit the other queues starting from the next worker, so thieves spread out
+        const std::size_t threads = _queues.size();
+
+        for (std::size_t offset = 1; offset < threads; ++offset) {
+            TaskQueue& victim = _queues[(worker + offset) % threads];
+            std::lock_guard lock(victim.mutex);
+
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    auto BatchSolver::RunTask(const unsigned int worker, Task& task) noexcept -> bool {
+        const PathQuery& query = _queries[task.query];
+        Pathfinder::Result& result = (*_results)[task.query];
+
+        // Slicing needs a context that can outlive this call, without a spare the search runs whole
+        if (task.context == nullptr && _timeSlice > std::chrono::nanoseconds::zero()) {
+            std::lock_guard lock(_contextMutex);
+
+            if (!_spareContexts.empty()) {
+                task.context = _spareContexts.back();
+                _spareContexts.pop_back();
+                task.context->Initialize(query.start, query.end);
+            }
+        }
+
+        if (task.context == nullptr) {
+            result = _contexts[worker].FindPath(query.start, query.end);
+            return true;
+        }
+
+        const Pathfinder::Progress progress = task.context->Update(Pathfinder::Budget{ .maxTime = _timeSlice });
+
+        if (progress.status == Pathfinder::Status::InProgress) {
+            return false;
+        }
+
+        result = { progress.status, task.context->GetPath(), task.context->GetCost(), task.context->GetStatistics() };
+
+        std::lock_guard lock(_contextMutex);
+        _spareContexts.push_back(task.context);
+        task.context = nullptr;
+        return true;
+    }
+} // namespace AStar
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "Grid.hpp"
+#include "JumpTable.hpp"
+#include "LandmarkTable.hpp"
+#include "Pathfinder.hpp"
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Start and end tiles of a single path request
+    struct PathQuery {
+        Vector2 start;
+        Vector2 end;
+    };
+
+    // Solves batches of path queries on one shared grid with a pool of worker threads.
+    // Every worker keeps its own Pathfinder as search context, so scratch memory is
+    // allocated once per thread and reused across batches while the grid itself is shared.
+    // Queries are dealt out to per-worker queues and idle workers steal from the others,
+    // so a few long searches do not leave the rest of the batch stuck behind them.
+    class BatchSolver final {
+    public:
+        // Starts the workers. A thread count of zero uses one worker per hardware thread.
+        explicit BatchSolver(std::shared_ptr<const Grid> grid, const SearchOptions& options = {}, unsigned int threadCount = 0) noexcept;
+        ~BatchSolver() noexcept;
+
+        BatchSolver(const BatchSolver&) = delete;
+        auto operator=(const BatchSolver&) -> BatchSolver& = delete;
+
+        [[nodiscard]] auto ThreadCount() const noexcept -> unsigned int;
+
+        // Splits searches into slices of roughly this length. A search that runs out of time
+        // is suspended with its context and can be resumed by whichever worker takes it next.
+        // Zero, the default, runs every search to completion in one go.
+        auto SetTimeSlice(std::chrono::nanoseconds slice) noexcept -> void;
+
+        // Shares landmark costs with every context, so the table is built once for the whole pool
+        auto SetLandmarks(std::shared_ptr<const LandmarkTable> table) noexcept -> void;
+
+        // Solves every query and returns the results in query order.
+        // Batches submitted from several threads are solved one after another.
+        [[nodiscard]] auto Solve(std::span<const PathQuery> queries) noexcept -> std::vector<Pathfinder::Result>;
+
+    private:
+        // A query waiting to be searched, or a suspended search carrying its context
+        struct Task {
+            std::size_t query;
+            Pathfinder* context;
+        };
+
+        // Tasks owned by one worker. The owner works from the back, thieves take from the front.
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        // Waits for batches and solves tasks until the batch is done
+        auto Work(unsigned int worker) noexcept -> void;
+
+        // Takes a task from the worker's own queue, or failing that from another worker's
+        auto NextTask(unsigned int worker, Task& task) noexcept -> bool;
+
+        // Searches the task, returning false if it was suspended instead of finished
+        auto RunTask(unsigned int worker, Task& task) noexcept -> bool;
+
+        std::shared_ptr<const Grid> _grid;
+        std::shared_ptr<const JumpTable> _jumpTable;
+        std::chrono::nanoseconds _timeSlice { 0 };
+
+        // One context per worker, then a bounded set lent out to suspended searches
+        std::vector<Pathfinder> _contexts;
+        std::vector<Pathfinder*> _spareContexts;
+        std::mutex _contextMutex;
+
+        std::vector<TaskQueue> _queues;
+        std::atomic<std::size_t> _remaining = 0;
+        std::vector<std::jthread> _workers;
+
+        // Workers without tasks sleep until a suspended search is queued again or the batch ends.
+        // The count only changes under the hand-off mutex, so no wake-up is missed.
+        std::condition_variable _taskQueued;
+        std::atomic<std::size_t> _requeued = 0;
+
+        // Batch hand-off, guarded by the mutex
+        std::mutex _solveMutex;
+        std::mutex _mutex;
+        std::condition_variable _batchReady;
+        std::condition_variable _batchDone;
+        std::span<const PathQuery> _queries;
+        std::vector<Pathfinder::Result>* _results = nullptr;
+        std::size_t _batch = 0;
+        unsigned int _pending = 0;
+        bool _stopping = false;
+    };
+} // namespace AStar
@@ -0,0 +1,132 @@
+#include "BucketQueue.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace AStar {
+    BucketQueue::BucketQueue() noexcept : _buckets(64) {
+
+    }
+
+    auto BucketQueue::Reserve(const int capacity) noexcept -> void {
+        for (auto& bucket : _buckets) {
+            bucket.clear();
+        }
+
+        _keys.assign(capacity, Absent);
+        _size = 0;
+    }
+
+    auto BucketQueue::Empty() const noexcept -> bool {
+        return _size == 0;
+    }
+
+    auto BucketQueue::Size() const noexcept -> std::size_t {
+        return _size;
+    }
+
+    auto BucketQueue::Contains(const int index) const noexcept -> bool {
+        return _keys[index] != Absent;
+    }
+
+    auto BucketQueue::Top() const noexcept -> int {
+        return _buckets[_minimum & (_buckets.size() - 1)].back();
+    }
+
+    auto BucketQueue::TopPriority() const noexcept -> Priority {
+        return _minimum;
+    }
+
+    auto BucketQueue::Push(const int index, const Priority priority) noexcept -> void {
+        if (_size == 0) {
+            _minimum = priority;
+            _maximum = priority;
+        }
+
+        ++_size;
+        Insert(index, priority);
+    }
+
+    auto BucketQueue::DecreaseKey(const int index, const Priority priority) noexcept -> void {
+        // The old entry stays in its bucket and is recognised as stale by its key
+        Insert(index, priority);
+    }
+
+    auto BucketQueue::Pop() noexcept -> int {
+        auto& bucket = BucketOf(_minimum);
+        const int top = bucket.back();
+        bucket.pop_back();
+
+        _keys[top] = Absent;
+        --_size;
+
+        if (_size > 0) {
+            Settle();
+        }
+
+        return top;
+    }
+
+    auto BucketQueue::Clear() noexcept -> void {
+        for (auto& bucket : _buckets) {
+            for (const int index : bucket) {
+                _keys[index] = Absent;
+            }
+
+            bucket.clear();
+        }
+
+        _size = 0;
+    }
+
+    auto BucketQueue::Insert(const int index, const Priority priority) noexcept -> void {
+        _keys[index] = priority;
+
+        const Priority low = std::min(_minimum, priority);
+        const Priority high = std::max(_maximum, priority);
+
+        if (high - low >= _buckets.size()) {
+            Grow(high - low);
+        }
+
+        _minimum = low;
+        _maximum = high;
+        BucketOf(priority).push_back(index);
+    }
+
+    auto BucketQueue::Settle() noexcept -> void {
+        while (true) {
+            auto& bucket = BucketOf(_minimum);
+
+            // Live keys span less than the ring, so anything here not filed under the cursor key is stale
+            while (!bucket.empty() && _keys[bucket.back()] != _minimum) {
+                bucket.pop_back();
+            }
+
+            if (!bucket.empty()) {
+                return;
+            }
+
+            ++_minimum;
+        }
+    }
+
+    auto BucketQueue::Grow(const Priority range) noexcept -> void {
+        const std::size_t size = std::bit_ceil(static_cast<std::size_t>(range) + 1);
+        std::vector<std::vector<int>> buckets(std::max(size, _buckets.size() * 2));
+
+        // Refile everything still in the queue under its current key and drop the rest
+        for (auto& bucket : _buckets) {
+            for (const int index : bucket) {
+                if (_keys[index] != Absent) {
+                    buckets[_keys[index] & (buckets.size() - 1)].push_back(index);
+                }
+            }
+        }
+
+        _buckets = std::move(buckets);
+    }
+
+    auto BucketQueue::BucketOf(const Priority priority) noexcept -> std::vector<int>& {
+        return _buckets[priority & (_buckets.size() - 1)];
+    }
+} // namespace AStar
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace AStar {
+    // Priority queue of element indices keyed by small integers.
+    // Keys map onto a circular array of buckets, so push and pop are O(1) amortized as long as
+    // the live keys span a narrow range, which holds for A* with integer step costs.
+    // Lowered keys leave a stale entry behind that is skipped when its bucket is reached.
+    class BucketQueue final {
+    public:
+        using Priority = std::uint32_t;
+
+        BucketQueue() noexcept;
+
+        // Sizes the key table for element indices in [0, capacity) and empties the queue
+        auto Reserve(int capacity) noexcept -> void;
+
+        [[nodiscard]] auto Empty() const noexcept -> bool;
+        [[nodiscard]] auto Size() const noexcept -> std::size_t;
+
+        // Checks if the element is currently in the queue
+        [[nodiscard]] auto Contains(int index) const noexcept -> bool;
+
+        // Gets the element with the lowest key
+        [[nodiscard]] auto Top() const noexcept -> int;
+
+        // Gets the lowest key in the queue
+        [[nodiscard]] auto TopPriority() const noexcept -> Priority;
+
+        // Inserts an element that is not yet in the queue
+        auto Push(int index, Priority priority) noexcept -> void;
+
+        // Lowers the key of an element already in the queue
+        auto DecreaseKey(int index, Priority priority) noexcept -> void;
+
+        // Removes and returns the element with the lowest key
+        auto Pop() noexcept -> int;
+
+        // Empties the queue
+        auto Clear() noexcept -> void;
+
+    private:
+        static constexpr Priority Absent = std::numeric_limits<Priority>::max();
+
+        // Files the element under the key, growing the bucket ring if the key falls outside it
+        auto Insert(int index, Priority priority) noexcept -> void;
+
+        // Drops stale entries and advances to the lowest non-empty bucket
+        auto Settle() noexcept -> void;
+
+        // Doubles the bucket ring until it covers the live key range and redistributes the entries
+        auto Grow(Priority range) noexcept -> void;
+
+        [[nodiscard]] auto BucketOf(Priority priority) noexcept -> std::vector<int>&;
+
+        std::vector<std::vector<int>> _buckets;
+        std::vector<Priority> _keys;
+        std::size_t _size = 0;
+        Priority _minimum = 0;
+        Priority _maximum = 0;
+    };
+} // namespace AStar
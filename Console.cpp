@@ -1,4 +1,5 @@
 #include "Console.hpp"
+#include "Trace.hpp"
 #include "Windows.hpp"
 #include <format>
 
@@ -109,6 +110,8 @@ namespace AStar {
     }
 
     auto Console::SwapBuffers() noexcept -> void {
+        const TraceScope trace("Console::SwapBuffers");
+
         // Clear the console and write to the output buffer
         Clear();
         WriteConsole(ScreenBuffer[RenderingScreenBufferIndex], writeBuffer.c_str(), writeBuffer.length(), nullptr, nullptr);
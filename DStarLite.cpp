@@ -0,0 +1,299 @@
+#include "DStarLite.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace AStar {
+    DStarLite::DStarLite(const Grid& grid, const Vector2 start, const Vector2 goal, const Neighbourhood neighbourhood) noexcept
+    : _grid(grid), _neighbourhood(neighbourhood), _position(start), _goal(goal) {
+        const std::size_t nodeCount = static_cast<std::size_t>(_grid.Width()) * _grid.Height();
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+
+        _nodes.assign(nodeCount, { infinity, infinity });
+        _openSet.Reserve(static_cast<int>(nodeCount));
+
+        // The search runs backwards, so it starts out knowing only the goal
+        const int goalIndex = Index(goal);
+        _nodes[goalIndex].rhs = 0;
+        _openSet.Push(goalIndex, KeyOf(goalIndex));
+    }
+
+    auto DStarLite::UpdateObstacles(const std::span<const Vector2> added, const std::span<const Vector2> removed) noexcept -> void {
+        std::vector<Vector2> changed;
+
+        for (const Vector2& tile : added) {
+            if (Contains(tile) && _grid.GetPassability().IsPassable(tile)) {
+                _grid.SetObstacle(tile);
+                changed.push_back(tile);
+            }
+        }
+
+        for (const Vector2& tile : removed) {
+            if (Contains(tile) && !_grid.GetPassability().IsPassable(tile)) {
+                _grid.ClearObstacle(tile);
+                changed.push_back(tile);
+            }
+        }
+
+        Repair(changed);
+    }
+
+    auto DStarLite::UpdateCosts(const std::span<const Vector2> tiles, const std::uint8_t cost) noexcept -> void {
+        std::vector<Vector2> changed;
+
+        for (const Vector2& tile : tiles) {
+            if (Contains(tile) && _grid.GetCost(tile) != std::max<std::uint8_t>(cost, 1)) {
+                _grid.SetCost(tile, cost);
+                changed.push_back(tile);
+            }
+        }
+
+        Repair(changed);
+    }
+
+    auto DStarLite::Repair(const std::span<const Vector2> changed) noexcept -> void {
+        // A tile's steps are all to its neighbours, and the diagonals it can block run between them,
+        // so only the tile and its ring of neighbours have steps whose cost changed
+        for (const Vector2& tile : changed) {
+            UpdateTile(Index(tile));
+
+            for (const Vector2& direction : _directions) {
+                const Vector2 neighbour = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+
+                if (Contains(neighbour)) {
+                    UpdateTile(Index(neighbour));
+                }
+            }
+        }
+    }
+
+    auto DStarLite::MoveTo(const Vector2 position) noexcept -> void {
+        // Raising the key modifier by how far the agent moved keeps the queued keys valid lower bounds,
+        // so they do not all have to be recomputed for the new heuristic origin
+        _keyModifier += EstimateDistance(_position, position);
+        _position = position;
+    }
+
+    auto DStarLite::Plan() noexcept -> Pathfinder::Result {
+        _expansions = 0;
+        ComputeShortestPath();
+
+        Pathfinder::Result result = { Pathfinder::Status::Error, {}, _nodes[Index(_position)].gScore, {} };
+
+        if (result.cost == std::numeric_limits<double>::infinity()) {
+            return result;
+        }
+
+        // Follow the cheapest step from every tile, the g-scores lead down to the goal
+
+        Vector2 tile = _position;
+        result.path.push_back(tile);
+
+        while (tile != _goal) {
+            double best = std::numeric_limits<double>::infinity();
+            Vector2 next = tile;
+
+            for (const Vector2& direction : std::span(_directions).first(DirectionCount())) {
+                const double cost = StepCost(tile, direction);
+
+                if (cost == std::numeric_limits<double>::infinity()) {
+                    continue;
+                }
+
+                const Vector2 neighbour = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+                const double through = cost + _nodes[Index(neighbour)].gScore;
+
+                if (through < best) {
+                    best = through;
+                    next = neighbour;
+                }
+            }
+
+            // A path can never be longer than the map, stop rather than walk in circles
+            if (next == tile || result.path.size() > _nodes.size()) {
+                return { Pathfinder::Status::Error, {}, std::numeric_limits<double>::infinity(), {} };
+            }
+
+            tile = next;
+            result.path.push_back(tile);
+        }
+
+        result.status = Pathfinder::Status::Success;
+        return result;
+    }
+
+    auto DStarLite::GetGrid() const noexcept -> const Grid& {
+        return _grid;
+    }
+
+    auto DStarLite::GetPosition() const noexcept -> Vector2 {
+        return _position;
+    }
+
+    auto DStarLite::GetGoal() const noexcept -> Vector2 {
+        return _goal;
+    }
+
+    auto DStarLite::GetExpansions() const noexcept -> std::size_t {
+        return _expansions;
+    }
+
+    auto DStarLite::ComputeShortestPath() noexcept -> void {
+        const int start = Index(_position);
+
+        while (!_openSet.Empty()) {
+            const int current = _openSet.Top();
+            const Key queued = _openSet.TopPriority();
+            const Key limit = KeyOf(start);
+
+            // Sums of diagonal costs round differently along different routes, so the heap cannot be
+            // trusted to order keys that tie with the agent's. Every such tie is expanded, extra expansions are always safe.
+            const bool ahead = queued.primary <= limit.primary + KeyTolerance;
+
+            if (!ahead && _nodes[start].rhs == _nodes[start].gScore) {
+                break;
+            }
+
+            const Key key = KeyOf(current);
+
+            // Keys queued before the agent moved are too low, requeue the tile under its current key
+            if (queued < key) {
+                _openSet.UpdateKey(current, key);
+                continue;
+            }
+
+            ++_expansions;
+
+            Node& node = _nodes[current];
+            const Vector2 tile = PositionOf(current);
+            const std::span directions = std::span(_directions).first(DirectionCount());
+
+            if (node.gScore > node.rhs) {
+                // Overconsistent, the tile got cheaper and the lower cost is passed on to its neighbours
+                node.gScore = node.rhs;
+                _openSet.Pop();
+
+                for (const Vector2& direction : directions) {
+                    // The neighbour's lookahead is over the step from it back onto this tile
+                    const Vector2 neighbourTile = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+                    const double cost = Contains(neighbourTile)
+                        ? StepCost(neighbourTile, { static_cast<short>(-direction.X), static_cast<short>(-direction.Y) })
+                        : std::numeric_limits<double>::infinity();
+
+                    if (cost == std::numeric_limits<double>::infinity()) {
+                        continue;
+                    }
+
+                    const int neighbour = Index(neighbourTile);
+
+                    if (node.gScore + cost < _nodes[neighbour].rhs) {
+                        _nodes[neighbour].rhs = node.gScore + cost;
+                        Requeue(neighbour);
+                    }
+                }
+            }
+            else {
+                // Underconsistent, the tile got dearer so it and every neighbour that may have relied on it are recomputed
+                node.gScore = std::numeric_limits<double>::infinity();
+
+                for (const Vector2& direction : directions) {
+                    const Vector2 neighbour = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+
+                    if (Contains(neighbour)) {
+                        UpdateTile(Index(neighbour));
+                    }
+                }
+
+                UpdateTile(current);
+            }
+        }
+    }
+
+    auto DStarLite::UpdateTile(const int index) noexcept -> void {
+        Node& node = _nodes[index];
+        const Vector2 tile = PositionOf(index);
+
+        // The goal's lookahead stays at zero, every other tile takes its cheapest step
+        if (tile != _goal) {
+            node.rhs = std::numeric_limits<double>::infinity();
+
+            for (const Vector2& direction : std::span(_directions).first(DirectionCount())) {
+                const double cost = StepCost(tile, direction);
+
+                if (cost != std::numeric_limits<double>::infinity()) {
+                    const Vector2 neighbour = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+                    node.rhs = std::min(node.rhs, cost + _nodes[Index(neighbour)].gScore);
+                }
+            }
+        }
+
+        Requeue(index);
+    }
+
+    auto DStarLite::Requeue(const int index) noexcept -> void {
+        const Node& node = _nodes[index];
+
+        // Only inconsistent tiles are queued
+
+        const bool inconsistent = node.gScore != node.rhs;
+
+        if (_openSet.Contains(index)) {
+            if (inconsistent) {
+                _openSet.UpdateKey(index, KeyOf(index));
+            }
+            else {
+                _openSet.Remove(index);
+            }
+        }
+        else if (inconsistent) {
+            _openSet.Push(index, KeyOf(index));
+        }
+    }
+
+    auto DStarLite::KeyOf(const int index) const noexcept -> Key {
+        const double cost = std::min(_nodes[index].gScore, _nodes[index].rhs);
+        return { cost + EstimateDistance(_position, PositionOf(index)) + _keyModifier, cost };
+    }
+
+    auto DStarLite::StepCost(const Vector2 from, const Vector2 direction) const noexcept -> double {
+        const PassabilityMap& passability = _grid.GetPassability();
+
+        // Steps are checked from both ends, so a blocked tile cannot be left either
+        if (!passability.IsPassable(from) || !passability.CanMove(from, direction)) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        const Vector2 to = { static_cast<short>(from.X + direction.X), static_cast<short>(from.Y + direction.Y) };
+        return (direction.X != 0 && direction.Y != 0 ? std::numbers::sqrt2 : 1.0) * _grid.GetCost(to);
+    }
+
+    auto DStarLite::EstimateDistance(const Vector2 from, const Vector2 to) const noexcept -> double {
+        const int dx = std::abs(from.X - to.X);
+        const int dy = std::abs(from.Y - to.Y);
+
+        // Octile distance for diagonal moves, Manhattan distance otherwise.
+        // Left unscaled by terrain costs, so it stays a lower bound however the costs change.
+        if (_neighbourhood == Neighbourhood::Eight) {
+            return std::max(dx, dy) + (std::numbers::sqrt2 - 1) * std::min(dx, dy);
+        }
+
+        return dx + dy;
+    }
+
+    auto DStarLite::Contains(const Vector2 tile) const noexcept -> bool {
+        return tile.X >= 0 && tile.Y >= 0 && tile.X < _grid.Width() && tile.Y < _grid.Height();
+    }
+
+    auto DStarLite::Index(const Vector2 tile) const noexcept -> int {
+        return tile.Y * _grid.Width() + tile.X;
+    }
+
+    auto DStarLite::PositionOf(const int index) const noexcept -> Vector2 {
+        return { static_cast<short>(index % _grid.Width()), static_cast<short>(index / _grid.Width()) };
+    }
+
+    auto DStarLite::DirectionCount() const noexcept -> std::size_t {
+        return _neighbourhood == Neighbourhood::Eight ? 8 : 4;
+    }
+} // namespace AStar
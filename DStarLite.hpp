@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Grid.hpp"
+#include "IndexedHeap.hpp"
+#include "Pathfinder.hpp"
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Incremental planner for an agent moving towards a fixed goal while obstacles change.
+    // It searches backwards from the goal and keeps its solution between calls, so after
+    // the agent moves or tiles are blocked, cleared or change cost only the affected tiles are expanded again.
+    class DStarLite final {
+    public:
+        DStarLite(const Grid& grid, Vector2 start, Vector2 goal, Neighbourhood neighbourhood = Neighbourhood::Four) noexcept;
+
+        // Blocks and clears tiles, queueing the tiles around every tile that changed for repair
+        auto UpdateObstacles(std::span<const Vector2> added, std::span<const Vector2> removed) noexcept -> void;
+
+        // Sets the terrain cost of the tiles, queueing the tiles around every tile that changed for repair
+        auto UpdateCosts(std::span<const Vector2> tiles, std::uint8_t cost) noexcept -> void;
+
+        // Sets the tile the agent is now on, paths are planned from there
+        auto MoveTo(Vector2 position) noexcept -> void;
+
+        // Repairs the solution after the changes since the last call and gets the path
+        // from the agent's position to the goal
+        [[nodiscard]] auto Plan() noexcept -> Pathfinder::Result;
+
+        [[nodiscard]] auto GetGrid() const noexcept -> const Grid&;
+        [[nodiscard]] auto GetPosition() const noexcept -> Vector2;
+        [[nodiscard]] auto GetGoal() const noexcept -> Vector2;
+
+        // Gets the number of tiles expanded by the last Plan call
+        [[nodiscard]] auto GetExpansions() const noexcept -> std::size_t;
+
+    private:
+        // Difference below which two key costs are treated as equal
+        static constexpr double KeyTolerance = 1e-6;
+
+        // Open list priority, compared lexicographically
+        struct Key {
+            double primary;   // Estimated cost of a path from the agent through the tile
+            double secondary; // Cost from the tile to the goal
+
+            auto operator<=>(const Key&) const noexcept = default;
+        };
+
+        // Costs to the goal, the tile is consistent when both agree
+        struct Node {
+            double gScore;
+            double rhs; // One step lookahead on the neighbours' g-scores
+        };
+
+        // Queues the changed tiles and their neighbours for repair
+        auto Repair(std::span<const Vector2> changed) noexcept -> void;
+
+        // Expands inconsistent tiles until the agent's tile is consistent and nothing cheaper is queued
+        auto ComputeShortestPath() noexcept -> void;
+
+        // Recomputes the lookahead of the tile and requeues it if it became inconsistent
+        auto UpdateTile(int index) noexcept -> void;
+
+        // Queues, requeues or drops the tile depending on whether it is consistent
+        auto Requeue(int index) noexcept -> void;
+
+        // Gets the open list priority of the tile
+        [[nodiscard]] auto KeyOf(int index) const noexcept -> Key;
+
+        // Gets the cost of a single step, infinite if the step cannot be taken
+        [[nodiscard]] auto StepCost(Vector2 from, Vector2 direction) const noexcept -> double;
+
+        // Heuristic distance between two tiles
+        [[nodiscard]] auto EstimateDistance(Vector2 from, Vector2 to) const noexcept -> double;
+
+        [[nodiscard]] auto Contains(Vector2 tile) const noexcept -> bool;
+        [[nodiscard]] auto Index(Vector2 tile) const noexcept -> int;
+        [[nodiscard]] auto PositionOf(int index) const noexcept -> Vector2;
+
+        // Gets the number of directions to step in
+        [[nodiscard]] auto DirectionCount() const noexcept -> std::size_t;
+
+        Grid _grid;
+        Neighbourhood _neighbourhood;
+        std::vector<Node> _nodes;
+        IndexedHeap<Key> _openSet;
+        Vector2 _position;
+        Vector2 _goal;
+        double _keyModifier = 0; // Heuristic distance the agent has moved, added to new keys
+        std::size_t _expansions = 0;
+
+        // Cardinal directions first, so 4-connected searches use the leading half
+        std::array<Vector2, 8> _directions { {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+        } };
+    };
+} // namespace AStar
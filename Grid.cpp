@@ -0,0 +1,75 @@
+#include "Grid.hpp"
+#include <algorithm>
+
+namespace AStar {
+    Grid::Grid() noexcept : _passability({ 0, 0 }) {
+
+    }
+
+    Grid::Grid(const Vector2 dimensions, const std::span<const Vector2> obstacles) noexcept : _passability(dimensions) {
+        for (const Vector2& obstacle : obstacles) {
+            _passability.SetBlocked(obstacle);
+        }
+    }
+
+    auto Grid::Width() const noexcept -> short {
+        return _passability.Width();
+    }
+
+    auto Grid::Height() const noexcept -> short {
+        return _passability.Height();
+    }
+
+    auto Grid::GetPassability() const noexcept -> const PassabilityMap& {
+        return _passability;
+    }
+
+    auto Grid::SetObstacle(const Vector2 tile) noexcept -> void {
+        _passability.SetBlocked(tile);
+    }
+
+    auto Grid::ClearObstacle(const Vector2 tile) noexcept -> void {
+        _passability.SetPassable(tile);
+    }
+
+    auto Grid::GetCost(const Vector2 tile) const noexcept -> std::uint8_t {
+        return _costs.empty() ? 1 : _costs[tile.Y * Width() + tile.X];
+    }
+
+    auto Grid::MinimumCost() const noexcept -> std::uint8_t {
+        if (_costs.empty()) {
+            return 1;
+        }
+
+        const auto cheapest = std::ranges::find_if(_costCounts, [](const int count) { return count > 0; });
+        return static_cast<std::uint8_t>(cheapest - _costCounts.begin());
+    }
+
+    auto Grid::HasTerrainCosts() const noexcept -> bool {
+        return !_costs.empty();
+    }
+
+    auto Grid::SetCost(const Vector2 tile, std::uint8_t cost) noexcept -> void {
+        cost = std::max<std::uint8_t>(cost, 1);
+
+        if (_costs.empty()) {
+            if (cost == 1) {
+                return;
+            }
+
+            _costs.assign(static_cast<std::size_t>(Width()) * Height(), 1);
+            _costCounts[1] = static_cast<int>(_costs.size());
+        }
+
+        std::uint8_t& current = _costs[tile.Y * Width() + tile.X];
+        --_costCounts[current];
+        ++_costCounts[cost];
+        current = cost;
+
+        // Back to uniform costs, drop the layer again
+        if (_costCounts[1] == static_cast<int>(_costs.size())) {
+            _costs.clear();
+            _costCounts = {};
+        }
+    }
+} // namespace AStar
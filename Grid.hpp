@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "PassabilityMap.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Map data searched by pathfinders.
+    // A grid is edited while it is being set up and then shared read-only,
+    // so any number of pathfinders on any number of threads can search it at once.
+    class Grid final {
+    public:
+        Grid() noexcept;
+        Grid(Vector2 dimensions, std::span<const Vector2> obstacles) noexcept;
+
+        [[nodiscard]] auto Width() const noexcept -> short;
+        [[nodiscard]] auto Height() const noexcept -> short;
+
+        [[nodiscard]] auto GetPassability() const noexcept -> const PassabilityMap&;
+
+        // Blocks the tile
+        auto SetObstacle(Vector2 tile) noexcept -> void;
+
+        // Unblocks the tile
+        auto ClearObstacle(Vector2 tile) noexcept -> void;
+
+        // Gets the cost of entering the tile, multiplied by the length of the step
+        [[nodiscard]] auto GetCost(Vector2 tile) const noexcept -> std::uint8_t;
+
+        // Gets the lowest cost of any tile, heuristics scaled by it stay admissible
+        [[nodiscard]] auto MinimumCost() const noexcept -> std::uint8_t;
+
+        // Checks if any tile costs more than the default of one
+        [[nodiscard]] auto HasTerrainCosts() const noexcept -> bool;
+
+        // Sets the cost of entering the tile. Zero is raised to one, tiles are blocked with SetObstacle.
+        auto SetCost(Vector2 tile, std::uint8_t cost) noexcept -> void;
+
+    private:
+        PassabilityMap _passability;
+
+        // Costs are only stored once a tile differs from the default, so uniform maps
+        // keep the lean layout. The count of tiles at each cost tracks the minimum.
+        std::vector<std::uint8_t> _costs;
+        std::array<int, 256> _costCounts {};
+    };
+} // namespace AStar
@@ -0,0 +1,549 @@
+#include "HierarchicalPathfinder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace AStar {
+    HierarchicalPathfinder::HierarchicalPathfinder(std::shared_ptr<const Grid> grid, const short clusterSize, const Neighbourhood neighbourhood) noexcept
+    : _grid(std::move(grid)), _clusterSize(std::max<short>(clusterSize, 1)), _neighbourhood(neighbourhood) {
+        _clustersX = static_cast<short>((_grid->Width() + _clusterSize - 1) / _clusterSize);
+        _clustersY = static_cast<short>((_grid->Height() + _clusterSize - 1) / _clusterSize);
+        _clusters.resize(static_cast<std::size_t>(_clustersX) * _clustersY);
+
+        // Clusters along the right and bottom edges are cut short by the map
+
+        for (int y = 0; y < _clustersY; ++y) {
+            for (int x = 0; x < _clustersX; ++x) {
+                Cluster& cluster = _clusters[y * _clustersX + x];
+                cluster.origin = { static_cast<short>(x * _clusterSize), static_cast<short>(y * _clusterSize) };
+                cluster.size = {
+                    static_cast<short>(std::min<int>(_clusterSize, _grid->Width() - cluster.origin.X)),
+                    static_cast<short>(std::min<int>(_clusterSize, _grid->Height() - cluster.origin.Y))
+                };
+            }
+        }
+
+        const int localCount = _clusterSize * _clusterSize;
+        _localCosts.resize(localCount);
+        _localParents.resize(localCount);
+        _localOpenSet.Reserve(localCount);
+
+        for (std::size_t i = 0; i < _clusters.size(); ++i) {
+            BuildCluster(static_cast<int>(i));
+        }
+
+        Renumber();
+    }
+
+    auto HierarchicalPathfinder::Update(std::shared_ptr<const Grid> grid, const std::span<const Vector2> changed) noexcept -> void {
+        _grid = std::move(grid);
+
+        std::vector<int> touched;
+
+        for (const Vector2& tile : changed) {
+            if (!Contains(tile)) {
+                continue;
+            }
+
+            const int cluster = ClusterOf(tile);
+            const Cluster& bounds = _clusters[cluster];
+            touched.push_back(cluster);
+
+            // Tiles on a border also shape the openings the cluster beyond it sees
+
+            if (tile.X == bounds.origin.X && tile.X > 0) {
+                touched.push_back(cluster - 1);
+            }
+
+            if (tile.X == bounds.origin.X + bounds.size.X - 1 && tile.X < _grid->Width() - 1) {
+                touched.push_back(cluster + 1);
+            }
+
+            if (tile.Y == bounds.origin.Y && tile.Y > 0) {
+                touched.push_back(cluster - _clustersX);
+            }
+
+            if (tile.Y == bounds.origin.Y + bounds.size.Y - 1 && tile.Y < _grid->Height() - 1) {
+                touched.push_back(cluster + _clustersX);
+            }
+        }
+
+        std::ranges::sort(touched);
+        const auto [first, last] = std::ranges::unique(touched);
+        touched.erase(first, last);
+
+        for (const int cluster : touched) {
+            BuildCluster(cluster);
+        }
+
+        Renumber();
+    }
+
+    auto HierarchicalPathfinder::FindPath(const Vector2 start, const Vector2 end) noexcept -> Pathfinder::Result {
+        Pathfinder::Result result = FindAbstractPath(start, end);
+
+        if (result.status != Pathfinder::Status::Success) {
+            return result;
+        }
+
+        // Step through every leg between consecutive waypoints
+
+        std::vector<Vector2> path = { result.path.front() };
+
+        for (std::size_t i = 1; i < result.path.size(); ++i) {
+            if (!RefineSegment(result.path[i - 1], result.path[i], path)) {
+                return { Pathfinder::Status::Error, {}, std::numeric_limits<double>::infinity(), {} };
+            }
+        }
+
+        result.path = std::move(path);
+        return result;
+    }
+
+    auto HierarchicalPathfinder::FindAbstractPath(const Vector2 start, const Vector2 end) noexcept -> Pathfinder::Result {
+        if (start == end && Contains(start) && _grid->GetPassability().IsPassable(start)) {
+            return { Pathfinder::Status::Success, { start }, 0, {} };
+        }
+
+        if (SearchAbstract(start, end) != Pathfinder::Status::Success) {
+            return { Pathfinder::Status::Error, {}, std::numeric_limits<double>::infinity(), {} };
+        }
+
+        const int endNode = _firstEntrance.back() + 1;
+        Pathfinder::Result result = { Pathfinder::Status::Success, {}, _nodes[endNode].gScore, {} };
+
+        // Entrances the start or end lie on show up twice, only keep them once
+
+        for (int node = endNode; node != -1; node = _nodes[node].cameFrom) {
+            const Vector2 tile = TileOf(node);
+
+            if (result.path.empty() || result.path.back() != tile) {
+                result.path.push_back(tile);
+            }
+        }
+
+        std::ranges::reverse(result.path);
+        return result;
+    }
+
+    auto HierarchicalPathfinder::RefineSegment(const Vector2 from, const Vector2 to, std::vector<Vector2>& path) noexcept -> bool {
+        if (from == to) {
+            return true;
+        }
+
+        const int cluster = ClusterOf(from);
+
+        // Legs between clusters are single steps over the border
+        if (cluster != ClusterOf(to)) {
+            if (std::abs(from.X - to.X) + std::abs(from.Y - to.Y) != 1) {
+                return false;
+            }
+
+            path.push_back(to);
+            return true;
+        }
+
+        const int source = LocalIndex(cluster, from);
+        const int target = LocalIndex(cluster, to);
+        SearchCluster(cluster, from, target);
+
+        if (_localCosts[target] == std::numeric_limits<double>::infinity()) {
+            return false;
+        }
+
+        // Walk the parents back from the target, then put the leg in order
+
+        const Cluster& bounds = _clusters[cluster];
+        const std::size_t first = path.size();
+
+        for (int index = target; index != source; index = _localParents[index]) {
+            path.push_back({
+                static_cast<short>(bounds.origin.X + index % bounds.size.X),
+                static_cast<short>(bounds.origin.Y + index / bounds.size.X)
+            });
+        }
+
+        std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+        return true;
+    }
+
+    auto HierarchicalPathfinder::GetGrid() const noexcept -> const Grid& {
+        return *_grid;
+    }
+
+    auto HierarchicalPathfinder::ClusterCount() const noexcept -> std::size_t {
+        return _clusters.size();
+    }
+
+    auto HierarchicalPathfinder::EntranceCount() const noexcept -> std::size_t {
+        return static_cast<std::size_t>(_firstEntrance.back());
+    }
+
+    auto HierarchicalPathfinder::BuildCluster(const int cluster) noexcept -> void {
+        Cluster& bounds = _clusters[cluster];
+        const Vector2 origin = bounds.origin;
+        const Vector2 size = bounds.size;
+        const int x = cluster % _clustersX;
+        const int y = cluster / _clustersX;
+
+        bounds.entrances.clear();
+
+        // Scan the borders shared with each neighbour
+
+        const auto right = static_cast<short>(origin.X + size.X - 1);
+        const auto bottom = static_cast<short>(origin.Y + size.Y - 1);
+
+        if (x > 0) {
+            AddEntrances(cluster, origin, { 0, 1 }, { -1, 0 }, size.Y);
+        }
+
+        if (x < _clustersX - 1) {
+            AddEntrances(cluster, { right, origin.Y }, { 0, 1 }, { 1, 0 }, size.Y);
+        }
+
+        if (y > 0) {
+            AddEntrances(cluster, origin, { 1, 0 }, { 0, -1 }, size.X);
+        }
+
+        if (y < _clustersY - 1) {
+            AddEntrances(cluster, { origin.X, bottom }, { 1, 0 }, { 0, 1 }, size.X);
+        }
+
+        // Corner tiles can open onto two neighbours, merge them into one entrance
+
+        std::ranges::sort(bounds.entrances, {}, &Entrance::tile);
+        std::vector<Entrance> merged;
+
+        for (Entrance& entrance : bounds.entrances) {
+            if (!merged.empty() && merged.back().tile == entrance.tile) {
+                merged.back().crossings.push_back(entrance.crossings.front());
+            }
+            else {
+                merged.push_back(std::move(entrance));
+            }
+        }
+
+        bounds.entrances = std::move(merged);
+
+        // One search from each entrance fills its row of the cost matrix, the costs from it to the others
+
+        const std::size_t count = bounds.entrances.size();
+        bounds.costs.assign(count * count, std::numeric_limits<double>::infinity());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            SearchCluster(cluster, PositionOf(bounds.entrances[i].tile));
+
+            for (std::size_t j = 0; j < count; ++j) {
+                bounds.costs[i * count + j] = _localCosts[LocalIndex(cluster, PositionOf(bounds.entrances[j].tile))];
+            }
+        }
+    }
+
+    auto HierarchicalPathfinder::AddEntrances(const int cluster, const Vector2 first, const Vector2 along, const Vector2 across, const int length) noexcept -> void {
+        const PassabilityMap& passability = _grid->GetPassability();
+        const int neighbour = ClusterOf({ static_cast<short>(first.X + across.X), static_cast<short>(first.Y + across.Y) });
+
+        const auto tileAt = [&](const int step) -> Vector2 {
+            return { static_cast<short>(first.X + along.X * step), static_cast<short>(first.Y + along.Y * step) };
+        };
+
+        const auto add = [&](const int step) {
+            const Vector2 tile = tileAt(step);
+            const Vector2 beyond = { static_cast<short>(tile.X + across.X), static_cast<short>(tile.Y + across.Y) };
+            _clusters[cluster].entrances.push_back({ Index(tile), { { neighbour, Index(beyond) } } });
+        };
+
+        // Openings are runs where both sides of the border are passable.
+        // The neighbour scans the same border in the same order, so both sides pick the same tiles.
+
+        int run = 0;
+
+        for (int step = 0; step <= length; ++step) {
+            const Vector2 tile = tileAt(step);
+
+            if (step < length && passability.IsPassable(tile)
+                && passability.IsPassable({ static_cast<short>(tile.X + across.X), static_cast<short>(tile.Y + across.Y) })) {
+                ++run;
+                continue;
+            }
+
+            if (run >= WideOpening) {
+                add(step - run);
+                add(step - 1);
+            }
+            else if (run > 0) {
+                add(step - run + (run - 1) / 2);
+            }
+
+            run = 0;
+        }
+    }
+
+    auto HierarchicalPathfinder::Renumber() noexcept -> void {
+        _firstEntrance.resize(_clusters.size() + 1);
+        _firstEntrance[0] = 0;
+
+        for (std::size_t i = 0; i < _clusters.size(); ++i) {
+            _firstEntrance[i + 1] = _firstEntrance[i] + static_cast<int>(_clusters[i].entrances.size());
+        }
+
+        // Two more nodes for the start and end of a query
+        const std::size_t nodeCount = static_cast<std::size_t>(_firstEntrance.back()) + 2;
+
+        if (_nodes.size() != nodeCount) {
+            _nodes.assign(nodeCount, Node{});
+            _openSet.Reserve(static_cast<int>(nodeCount));
+            _generation = 0;
+        }
+    }
+
+    auto HierarchicalPathfinder::SearchCluster(const int cluster, const Vector2 source, const int targetIndex, const bool reversed) noexcept -> void {
+        const Cluster& bounds = _clusters[cluster];
+        const PassabilityMap& passability = _grid->GetPassability();
+
+        std::fill_n(_localCosts.begin(), bounds.size.X * bounds.size.Y, std::numeric_limits<double>::infinity());
+        _localOpenSet.Clear();
+
+        const int sourceIndex = LocalIndex(cluster, source);
+        _localCosts[sourceIndex] = 0;
+        _localParents[sourceIndex] = -1;
+
+        // With uniform step costs a plain queue settles tiles in order of cost, so 4-connected
+        // searches go breadth-first and skip the heap, which matters when building large maps
+        const bool weighted = _grid->HasTerrainCosts();
+        const bool breadthFirst = _neighbourhood == Neighbourhood::Four && !weighted;
+        std::size_t head = 0;
+
+        if (breadthFirst) {
+            _localQueue.clear();
+            _localQueue.push_back(sourceIndex);
+        }
+        else {
+            _localOpenSet.Push(sourceIndex, 0);
+        }
+
+        const std::span directions = std::span(_directions).first(DirectionCount());
+
+        while (breadthFirst ? head < _localQueue.size() : !_localOpenSet.Empty()) {
+            const int current = breadthFirst ? _localQueue[head++] : _localOpenSet.Pop();
+
+            if (current == targetIndex) {
+                return;
+            }
+
+            const Vector2 tile = {
+                static_cast<short>(bounds.origin.X + current % bounds.size.X),
+                static_cast<short>(bounds.origin.Y + current / bounds.size.X)
+            };
+
+            for (const Vector2& direction : directions) {
+                const Vector2 neighbour = { static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) };
+
+                // Stay inside the cluster, a diagonal between two inside tiles only passes inside tiles
+                if (neighbour.X < bounds.origin.X || neighbour.Y < bounds.origin.Y
+                    || neighbour.X >= bounds.origin.X + bounds.size.X || neighbour.Y >= bounds.origin.Y + bounds.size.Y
+                    || !passability.CanMove(tile, direction)) {
+                    continue;
+                }
+
+                // A reversed search walks each step backwards, so the step enters the current tile
+                const int index = LocalIndex(cluster, neighbour);
+                const double length = direction.X != 0 && direction.Y != 0 ? std::numbers::sqrt2 : 1.0;
+                const double cost = _localCosts[current] + (weighted ? length * _grid->GetCost(reversed ? tile : neighbour) : length);
+
+                if (cost >= _localCosts[index]) {
+                    continue;
+                }
+
+                _localCosts[index] = cost;
+                _localParents[index] = current;
+
+                if (breadthFirst) {
+                    _localQueue.push_back(index);
+                }
+                else if (_localOpenSet.Contains(index)) {
+                    _localOpenSet.DecreaseKey(index, cost);
+                }
+                else {
+                    _localOpenSet.Push(index, cost);
+                }
+            }
+        }
+    }
+
+    auto HierarchicalPathfinder::SearchAbstract(const Vector2 start, const Vector2 end) noexcept -> Pathfinder::Status {
+        const PassabilityMap& passability = _grid->GetPassability();
+
+        if (!Contains(start) || !Contains(end) || !passability.IsPassable(start) || !passability.IsPassable(end)) {
+            return Pathfinder::Status::Error;
+        }
+
+        _start = start;
+        _end = end;
+
+        if (++_generation == 0) {
+            _nodes.assign(_nodes.size(), Node{});
+            _generation = 1;
+        }
+
+        // Connect the start and end to the entrances of their clusters.
+        // The search from the end walks the steps backwards to give the costs towards it.
+
+        const int startCluster = ClusterOf(start);
+        const int endCluster = ClusterOf(end);
+
+        SearchCluster(endCluster, end, -1, true);
+        _endCosts.clear();
+
+        for (const Entrance& entrance : _clusters[endCluster].entrances) {
+            _endCosts.push_back(_localCosts[LocalIndex(endCluster, PositionOf(entrance.tile))]);
+        }
+
+        _directCost = startCluster == endCluster ? _localCosts[LocalIndex(endCluster, start)] : std::numeric_limits<double>::infinity();
+
+        SearchCluster(startCluster, start);
+        _startCosts.clear();
+
+        for (const Entrance& entrance : _clusters[startCluster].entrances) {
+            _startCosts.push_back(_localCosts[LocalIndex(startCluster, PositionOf(entrance.tile))]);
+        }
+
+        // A* over the entrances
+
+        const int startNode = _firstEntrance.back();
+        const int endNode = startNode + 1;
+
+        _heuristicScale = _grid->MinimumCost();
+        _openSet.Clear();
+        NodeAt(startNode).gScore = 0;
+        _openSet.Push(startNode, EstimateDistance(start, end));
+
+        while (!_openSet.Empty()) {
+            const int current = _openSet.Pop();
+
+            if (current == endNode) {
+                return Pathfinder::Status::Success;
+            }
+
+            if (current == startNode) {
+                for (std::size_t i = 0; i < _startCosts.size(); ++i) {
+                    Relax(startNode, _firstEntrance[startCluster] + static_cast<int>(i), _startCosts[i], end);
+                }
+
+                Relax(startNode, endNode, _directCost, end);
+                continue;
+            }
+
+            const auto cluster = static_cast<int>(std::ranges::upper_bound(_firstEntrance, current) - _firstEntrance.begin() - 1);
+            const int slot = current - _firstEntrance[cluster];
+            const Cluster& bounds = _clusters[cluster];
+            const std::size_t count = bounds.entrances.size();
+
+            // Routes to the other entrances of the cluster
+
+            for (std::size_t i = 0; i < count; ++i) {
+                Relax(current, _firstEntrance[cluster] + static_cast<int>(i), bounds.costs[slot * count + i], end);
+            }
+
+            // Steps over the border
+
+            for (const Crossing& crossing : bounds.entrances[slot].crossings) {
+                const auto& entrances = _clusters[crossing.cluster].entrances;
+                const auto beyond = std::ranges::lower_bound(entrances, crossing.tile, {}, &Entrance::tile);
+                const double cost = _grid->GetCost(PositionOf(crossing.tile));
+                Relax(current, _firstEntrance[crossing.cluster] + static_cast<int>(beyond - entrances.begin()), cost, end);
+            }
+
+            if (cluster == endCluster) {
+                Relax(current, endNode, _endCosts[slot], end);
+            }
+        }
+
+        return Pathfinder::Status::Error;
+    }
+
+    auto HierarchicalPathfinder::Relax(const int from, const int to, const double cost, const Vector2 end) noexcept -> void {
+        if (cost == std::numeric_limits<double>::infinity() || from == to) {
+            return;
+        }
+
+        Node& node = NodeAt(to);
+        const double tentative = _nodes[from].gScore + cost;
+
+        if (tentative >= node.gScore) {
+            return;
+        }
+
+        node.gScore = tentative;
+        node.cameFrom = from;
+
+        const double fScore = tentative + EstimateDistance(TileOf(to), end);
+
+        if (_openSet.Contains(to)) {
+            _openSet.DecreaseKey(to, fScore);
+        }
+        else {
+            _openSet.Push(to, fScore);
+        }
+    }
+
+    auto HierarchicalPathfinder::NodeAt(const int index) noexcept -> Node& {
+        Node& node = _nodes[index];
+
+        if (node.generation != _generation) {
+            node = { std::numeric_limits<double>::infinity(), -1, _generation };
+        }
+
+        return node;
+    }
+
+    auto HierarchicalPathfinder::TileOf(const int node) const noexcept -> Vector2 {
+        const int total = _firstEntrance.back();
+
+        if (node >= total) {
+            return node == total ? _start : _end;
+        }
+
+        const auto cluster = std::ranges::upper_bound(_firstEntrance, node) - _firstEntrance.begin() - 1;
+        return PositionOf(_clusters[cluster].entrances[node - _firstEntrance[cluster]].tile);
+    }
+
+    auto HierarchicalPathfinder::ClusterOf(const Vector2 tile) const noexcept -> int {
+        return tile.Y / _clusterSize * _clustersX + tile.X / _clusterSize;
+    }
+
+    auto HierarchicalPathfinder::LocalIndex(const int cluster, const Vector2 tile) const noexcept -> int {
+        const Cluster& bounds = _clusters[cluster];
+        return (tile.Y - bounds.origin.Y) * bounds.size.X + (tile.X - bounds.origin.X);
+    }
+
+    auto HierarchicalPathfinder::Contains(const Vector2 tile) const noexcept -> bool {
+        return tile.X >= 0 && tile.Y >= 0 && tile.X < _grid->Width() && tile.Y < _grid->Height();
+    }
+
+    auto HierarchicalPathfinder::Index(const Vector2 tile) const noexcept -> int {
+        return tile.Y * _grid->Width() + tile.X;
+    }
+
+    auto HierarchicalPathfinder::PositionOf(const int index) const noexcept -> Vector2 {
+        return { static_cast<short>(index % _grid->Width()), static_cast<short>(index / _grid->Width()) };
+    }
+
+    auto HierarchicalPathfinder::EstimateDistance(const Vector2 from, const Vector2 to) const noexcept -> double {
+        const int dx = std::abs(from.X - to.X);
+        const int dy = std::abs(from.Y - to.Y);
+
+        // Octile distance for diagonal moves, Manhattan distance otherwise,
+        // scaled by the cheapest terrain cost so it never overestimates
+        if (_neighbourhood == Neighbourhood::Eight) {
+            return (std::max(dx, dy) + (std::numbers::sqrt2 - 1) * std::min(dx, dy)) * _heuristicScale;
+        }
+
+        return (dx + dy) * _heuristicScale;
+    }
+
+    auto HierarchicalPathfinder::DirectionCount() const noexcept -> std::size_t {
+        return _neighbourhood == Neighbourhood::Eight ? 8 : 4;
+    }
+} // namespace AStar
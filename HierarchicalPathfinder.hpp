@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Grid.hpp"
+#include "IndexedHeap.hpp"
+#include "Pathfinder.hpp"
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // HPA* search over an abstraction of the grid for long queries on large maps.
+    // The grid is cut into square clusters. Openings in the border between two clusters get
+    // entrance tiles, and the costs between the entrances of a cluster are precomputed.
+    // A query searches this small graph first and only then steps through the clusters on its way.
+    // Paths are near-optimal, as they always cross borders at the entrance tiles. There is no hard bound,
+    // as a short path may have to detour to an entrance, but on the seeded test maps they cost at most a quarter more.
+    // Like Pathfinder, it keeps scratch memory for its queries, so every thread needs its own.
+    class HierarchicalPathfinder final {
+    public:
+        HierarchicalPathfinder(std::shared_ptr<const Grid> grid, short clusterSize = 32, Neighbourhood neighbourhood = Neighbourhood::Four) noexcept;
+
+        // Switches to an edited copy of the grid, rebuilding only the clusters whose tiles
+        // or border openings the changed tiles are part of. Tiles whose terrain cost changed count as changed too.
+        // The dimensions must stay the same.
+        auto Update(std::shared_ptr<const Grid> grid, std::span<const Vector2> changed) noexcept -> void;
+
+        // Searches the abstraction and steps the result through every cluster
+        [[nodiscard]] auto FindPath(Vector2 start, Vector2 end) noexcept -> Pathfinder::Result;
+
+        // Searches the abstraction only. The path holds the start, the entrances passed through and the end,
+        // the tiles in between can be filled in one leg at a time with RefineSegment.
+        [[nodiscard]] auto FindAbstractPath(Vector2 start, Vector2 end) noexcept -> Pathfinder::Result;
+
+        // Appends the tiles after the first waypoint up to the second to the path.
+        // Returns false if the waypoints do not follow each other on an abstract path.
+        auto RefineSegment(Vector2 from, Vector2 to, std::vector<Vector2>& path) noexcept -> bool;
+
+        [[nodiscard]] auto GetGrid() const noexcept -> const Grid&;
+        [[nodiscard]] auto ClusterCount() const noexcept -> std::size_t;
+        [[nodiscard]] auto EntranceCount() const noexcept -> std::size_t;
+
+    private:
+        // Openings at least this wide get an entrance at each end instead of one in the middle
+        static constexpr int WideOpening = 6;
+
+        // Step from an entrance tile over the border into a neighbouring cluster
+        struct Crossing {
+            int cluster;
+            int tile;
+        };
+
+        struct Entrance {
+            int tile;
+            std::vector<Crossing> crossings;
+        };
+
+        struct Cluster {
+            Vector2 origin;
+            Vector2 size;
+            std::vector<Entrance> entrances; // Sorted by tile
+            std::vector<double> costs;       // Cheapest route inside the cluster between every pair of entrances
+        };
+
+        // Search state of an abstract node, the entrances numbered cluster by cluster followed by the start and end
+        struct Node {
+            double gScore;
+            int cameFrom;
+            unsigned int generation;
+        };
+
+        // Finds the entrances and their costs from the current grid
+        auto BuildCluster(int cluster) noexcept -> void;
+
+        // Adds entrances for the openings in the border between the cluster and a neighbour.
+        // The border runs along the given side of the cluster, with the neighbour one step beyond it.
+        auto AddEntrances(int cluster, Vector2 first, Vector2 along, Vector2 across, int length) noexcept -> void;
+
+        // Numbers the entrances of all clusters after some were rebuilt
+        auto Renumber() noexcept -> void;
+
+        // Finds the cheapest routes from the tile without leaving the cluster, stopping early once the target is settled.
+        // A reversed search finds the cheapest routes to the tile instead, which differ once tiles have terrain costs.
+        auto SearchCluster(int cluster, Vector2 source, int targetIndex = -1, bool reversed = false) noexcept -> void;
+
+        // Searches the abstract graph, leaving the node chain for FindAbstractPath to read
+        auto SearchAbstract(Vector2 start, Vector2 end) noexcept -> Pathfinder::Status;
+
+        // Relaxes an abstract edge
+        auto Relax(int from, int to, double cost, Vector2 end) noexcept -> void;
+
+        // Gets the node at the index, resetting it if it is stale
+        [[nodiscard]] auto NodeAt(int index) noexcept -> Node&;
+
+        // Gets the tile of an abstract node
+        [[nodiscard]] auto TileOf(int node) const noexcept -> Vector2;
+
+        [[nodiscard]] auto ClusterOf(Vector2 tile) const noexcept -> int;
+        [[nodiscard]] auto LocalIndex(int cluster, Vector2 tile) const noexcept -> int;
+        [[nodiscard]] auto Contains(Vector2 tile) const noexcept -> bool;
+        [[nodiscard]] auto Index(Vector2 tile) const noexcept -> int;
+        [[nodiscard]] auto PositionOf(int index) const noexcept -> Vector2;
+
+        // Heuristic distance between two tiles
+        [[nodiscard]] auto EstimateDistance(Vector2 from, Vector2 to) const noexcept -> double;
+
+        [[nodiscard]] auto DirectionCount() const noexcept -> std::size_t;
+
+        std::shared_ptr<const Grid> _grid;
+        short _clusterSize;
+        Neighbourhood _neighbourhood;
+        short _clustersX = 0, _clustersY = 0;
+        std::vector<Cluster> _clusters;
+        std::vector<int> _firstEntrance; // Node number of every cluster's first entrance, plus the total at the end
+
+        // Abstract search
+        std::vector<Node> _nodes;
+        IndexedHeap<double> _openSet;
+        unsigned int _generation = 0;
+        std::vector<double> _startCosts; // Costs from the start to the entrances of its cluster
+        std::vector<double> _endCosts;   // Costs from the entrances of the end's cluster to the end
+        double _directCost = 0;          // Cost from the start to the end inside their cluster, if they share one
+        double _heuristicScale = 1;      // Lowest terrain cost of the grid
+        Vector2 _start {}, _end {};
+
+        // Search inside a single cluster
+        std::vector<double> _localCosts;
+        std::vector<int> _localParents;
+        IndexedHeap<double> _localOpenSet;
+        std::vector<int> _localQueue;
+
+        // Cardinal directions first, so 4-connected searches use the leading half
+        std::array<Vector2, 8> _directions { {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+        } };
+    };
+} // namespace AStar
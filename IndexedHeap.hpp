@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AStar {
+    // Binary min-heap of element indices that tracks the heap position of every element,
+    // so membership checks are O(1) and priorities can be lowered in place.
+    template<typename PriorityType = double>
+    class IndexedHeap final {
+    public:
+        using Priority = PriorityType;
+
+        // Sizes the position table for element indices in [0, capacity) and empties the heap
+        auto Reserve(int capacity) noexcept -> void;
+
+        [[nodiscard]] auto Empty() const noexcept -> bool;
+        [[nodiscard]] auto Size() const noexcept -> std::size_t;
+
+        // Checks if the element is currently in the heap
+        [[nodiscard]] auto Contains(int index) const noexcept -> bool;
+
+        // Gets the element with the lowest priority
+        [[nodiscard]] auto Top() const noexcept -> int;
+
+        // Gets the lowest priority in the heap
+        [[nodiscard]] auto TopPriority() const noexcept -> Priority;
+
+        // Inserts an element that is not yet in the heap
+        auto Push(int index, Priority priority) noexcept -> void;
+
+        // Lowers the priority of an element already in the heap
+        auto DecreaseKey(int index, Priority priority) noexcept -> void;
+
+        // Changes the priority of an element already in the heap in either direction
+        auto UpdateKey(int index, Priority priority) noexcept -> void;
+
+        // Removes and returns the element with the lowest priority
+        auto Pop() noexcept -> int;
+
+        // Removes an arbitrary element from the heap
+        auto Remove(int index) noexcept -> void;
+
+        // Empties the heap, touching only the elements still in it
+        auto Clear() noexcept -> void;
+
+    private:
+        struct Entry {
+            Priority priority;
+            int index;
+        };
+
+        // Moves the entry at the position up until the heap property holds
+        auto SiftUp(std::size_t position) noexcept -> void;
+
+        // Moves the entry at the position down until the heap property holds
+        auto SiftDown(std::size_t position) noexcept -> void;
+
+        // Writes the entry to the position and records it in the position table
+        auto Place(std::size_t position, const Entry& entry) noexcept -> void;
+
+        std::vector<Entry> _entries;
+        std::vector<int> _positions;
+    };
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Reserve(const int capacity) noexcept -> void {
+        _entries.clear();
+        _positions.assign(capacity, -1);
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Empty() const noexcept -> bool {
+        return _entries.empty();
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Size() const noexcept -> std::size_t {
+        return _entries.size();
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Contains(const int index) const noexcept -> bool {
+        return _positions[index] != -1;
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Top() const noexcept -> int {
+        return _entries.front().index;
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::TopPriority() const noexcept -> Priority {
+        return _entries.front().priority;
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Push(const int index, const Priority priority) noexcept -> void {
+        _entries.push_back({ priority, index });
+        _positions[index] = static_cast<int>(_entries.size() - 1);
+        SiftUp(_entries.size() - 1);
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::DecreaseKey(const int index, const Priority priority) noexcept -> void {
+        const auto position = static_cast<std::size_t>(_positions[index]);
+        _entries[position].priority = priority;
+        SiftUp(position);
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::UpdateKey(const int index, const Priority priority) noexcept -> void {
+        const auto position = static_cast<std::size_t>(_positions[index]);
+        _entries[position].priority = priority;
+        SiftUp(position);
+        SiftDown(static_cast<std::size_t>(_positions[index]));
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Pop() noexcept -> int {
+        const int top = _entries.front().index;
+        Remove(top);
+        return top;
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Remove(const int index) noexcept -> void {
+        const auto position = static_cast<std::size_t>(_positions[index]);
+        _positions[index] = -1;
+
+        const Entry last = _entries.back();
+        _entries.pop_back();
+
+        if (position == _entries.size()) {
+            return;
+        }
+
+        // Fill the hole with the last entry and restore the heap in whichever direction is needed
+        Place(position, last);
+        SiftUp(position);
+        SiftDown(static_cast<std::size_t>(_positions[last.index]));
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Clear() noexcept -> void {
+        for (const auto& entry : _entries) {
+            _positions[entry.index] = -1;
+        }
+
+        _entries.clear();
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::SiftUp(std::size_t position) noexcept -> void {
+        const Entry entry = _entries[position];
+
+        while (position > 0) {
+            const std::size_t parent = (position - 1) / 2;
+
+            if (!(entry.priority < _entries[parent].priority)) {
+                break;
+            }
+
+            Place(position, _entries[parent]);
+            position = parent;
+        }
+
+        Place(position, entry);
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::SiftDown(std::size_t position) noexcept -> void {
+        const Entry entry = _entries[position];
+        const std::size_t size = _entries.size();
+
+        while (true) {
+            std::size_t child = position * 2 + 1;
+
+            if (child >= size) {
+                break;
+            }
+
+            // Pick the smaller child
+            if (child + 1 < size && _entries[child + 1].priority < _entries[child].priority) {
+                ++child;
+            }
+
+            if (!(_entries[child].priority < entry.priority)) {
+                break;
+            }
+
+            Place(position, _entries[child]);
+            position = child;
+        }
+
+        Place(position, entry);
+    }
+
+    template<typename PriorityType>
+    auto IndexedHeap<PriorityType>::Place(const std::size_t position, const Entry& entry) noexcept -> void {
+        _entries[position] = entry;
+        _positions[entry.index] = static_cast<int>(position);
+    }
+} // namespace AStar
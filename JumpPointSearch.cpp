@@ -0,0 +1,95 @@
+#include "JumpPointSearch.hpp"
+
+namespace AStar {
+    namespace {
+        auto Offset(const Vector2 tile, const int x, const int y) noexcept -> Vector2 {
+            return { static_cast<short>(tile.X + x), static_cast<short>(tile.Y + y) };
+        }
+    }
+
+    auto JumpPointSearch::Directions(const PassabilityMap& map, const Vector2 tile, const Vector2 direction, std::array<Vector2, 8>& directions) noexcept -> int {
+        const short dx = direction.X, dy = direction.Y;
+        int count = 0;
+
+        if (dx == 0 && dy == 0) {
+            // The start tile has no parent to prune against
+            directions = { {
+                { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+                { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+            } };
+            return 8;
+        }
+
+        if (dx != 0 && dy != 0) {
+            // Diagonal moves keep their two components and the diagonal itself
+            directions[count++] = { dx, 0 };
+            directions[count++] = { 0, dy };
+            directions[count++] = { dx, dy };
+            return count;
+        }
+
+        directions[count++] = { dx, dy };
+
+        if (dx != 0) {
+            // Horizontal move, a blocked tile behind either side forces that side open
+            for (const short side : { static_cast<short>(-1), static_cast<short>(1) }) {
+                if (!map.IsPassable(Offset(tile, -dx, side)) && map.IsPassable(Offset(tile, 0, side))) {
+                    directions[count++] = { 0, side };
+                    directions[count++] = { dx, side };
+                }
+            }
+        }
+        else {
+            // Vertical move
+            for (const short side : { static_cast<short>(-1), static_cast<short>(1) }) {
+                if (!map.IsPassable(Offset(tile, side, -dy)) && map.IsPassable(Offset(tile, side, 0))) {
+                    directions[count++] = { side, 0 };
+                    directions[count++] = { side, dy };
+                }
+            }
+        }
+
+        return count;
+    }
+
+    auto JumpPointSearch::HasForcedNeighbour(const PassabilityMap& map, const Vector2 tile, const Vector2 direction) noexcept -> bool {
+        if (direction.X != 0) {
+            return (!map.IsPassable(Offset(tile, -direction.X, -1)) && map.IsPassable(Offset(tile, 0, -1)))
+                || (!map.IsPassable(Offset(tile, -direction.X, 1)) && map.IsPassable(Offset(tile, 0, 1)));
+        }
+
+        return (!map.IsPassable(Offset(tile, -1, -direction.Y)) && map.IsPassable(Offset(tile, -1, 0)))
+            || (!map.IsPassable(Offset(tile, 1, -direction.Y)) && map.IsPassable(Offset(tile, 1, 0)));
+    }
+
+    auto JumpPointSearch::Jump(const PassabilityMap& map, const Vector2 from, const Vector2 direction, const Vector2 goal, Vector2& jumpPoint) noexcept -> bool {
+        const bool diagonal = direction.X != 0 && direction.Y != 0;
+        Vector2 current = from;
+
+        while (map.CanMove(current, direction)) {
+            current = Offset(current, direction.X, direction.Y);
+
+            if (current == goal) {
+                jumpPoint = current;
+                return true;
+            }
+
+            if (diagonal) {
+                // A diagonal tile is a jump point if a straight jump from it finds anything
+                Vector2 ignored;
+
+                if (Jump(map, current, { direction.X, 0 }, goal, ignored)
+                    || Jump(map, current, { 0, direction.Y }, goal, ignored)) {
+                    jumpPoint = current;
+                    return true;
+                }
+            }
+            else if (HasForcedNeighbour(map, current, direction)) {
+                jumpPoint = current;
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace AStar
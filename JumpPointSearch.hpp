@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include "PassabilityMap.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Jump point search rules for uniform-cost 8-connected grids where diagonals may not cut corners.
+    // Straight moves stop at tiles with a forced neighbour, diagonal moves stop where a straight
+    // jump along either component finds something, and everything in between is skipped.
+    class JumpPointSearch final {
+    public:
+        // Collects the pruned directions to search from a tile entered by moving in the direction.
+        // A zero direction marks the start tile, which searches in every direction.
+        static auto Directions(const PassabilityMap& map, Vector2 tile, Vector2 direction, std::array<Vector2, 8>& directions) noexcept -> int;
+
+        // Checks if a tile entered by a straight move has a neighbour only reachable optimally through it
+        [[nodiscard]] static auto HasForcedNeighbour(const PassabilityMap& map, Vector2 tile, Vector2 direction) noexcept -> bool;
+
+        // Moves from the tile in the direction until a jump point or the goal is found.
+        // Returns false if a wall is reached first.
+        static auto Jump(const PassabilityMap& map, Vector2 from, Vector2 direction, Vector2 goal, Vector2& jumpPoint) noexcept -> bool;
+    };
+} // namespace AStar
@@ -0,0 +1,175 @@
+#include "JumpTable.hpp"
+#include "JumpPointSearch.hpp"
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace AStar {
+    namespace {
+        // Same order as the distance slots
+        constexpr Vector2 Directions[8] = {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+        };
+
+        // Extends a distance found one step further along by one more step
+        auto StepBack(const int distance) noexcept -> int {
+            return distance > 0 ? distance + 1 : distance - 1;
+        }
+    }
+
+    JumpTable::JumpTable() noexcept = default;
+
+    JumpTable::JumpTable(const PassabilityMap& map) noexcept
+    : _width(map.Width()), _height(map.Height()), _fingerprint(map.Fingerprint()),
+      _distances(static_cast<std::size_t>(map.Width()) * map.Height() * 8, 0) {
+        _data = _distances.data();
+
+        const auto slot = [this](const Vector2 tile, const int direction) -> std::int16_t& {
+            return _distances[(static_cast<std::size_t>(tile.Y) * _width + tile.X) * 8 + direction];
+        };
+
+        // Straight directions come first because the diagonal sweeps read them
+        for (int direction = 0; direction < 8; ++direction) {
+            const auto [dx, dy] = Directions[direction];
+
+            // Sweep against the direction so the next tile along it is always done already
+            for (int row = 0; row < _height; ++row) {
+                const auto y = static_cast<short>(dy > 0 ? _height - 1 - row : row);
+
+                for (int column = 0; column < _width; ++column) {
+                    const auto x = static_cast<short>(dx > 0 ? _width - 1 - column : column);
+                    const Vector2 tile = { x, y };
+
+                    // Blocked tiles and tiles facing a wall keep a distance of zero
+                    if (!map.IsPassable(tile) || !map.CanMove(tile, Directions[direction])) {
+                        continue;
+                    }
+
+                    const Vector2 next = { static_cast<short>(x + dx), static_cast<short>(y + dy) };
+                    int distance;
+
+                    if (dx != 0 && dy != 0) {
+                        const bool straightJumpFound = slot(next, DirectionIndex({ dx, 0 })) > 0
+                            || slot(next, DirectionIndex({ 0, dy })) > 0;
+
+                        distance = straightJumpFound ? 1 : StepBack(slot(next, direction));
+                    }
+                    else {
+                        distance = JumpPointSearch::HasForcedNeighbour(map, next, Directions[direction]) ? 1 : StepBack(slot(next, direction));
+                    }
+
+                    slot(tile, direction) = static_cast<std::int16_t>(distance);
+                }
+            }
+        }
+    }
+
+    JumpTable::JumpTable(JumpTable&& other) noexcept
+    : _width(other._width), _height(other._height), _fingerprint(other._fingerprint),
+      _distances(std::move(other._distances)), _file(std::move(other._file)), _data(std::exchange(other._data, nullptr)) {
+
+    }
+
+    auto JumpTable::operator=(JumpTable&& other) noexcept -> JumpTable& {
+        _width = other._width;
+        _height = other._height;
+        _fingerprint = other._fingerprint;
+        _distances = std::move(other._distances);
+        _file = std::move(other._file);
+        _data = std::exchange(other._data, nullptr);
+        return *this;
+    }
+
+    auto JumpTable::Width() const noexcept -> short {
+        return _width;
+    }
+
+    auto JumpTable::Height() const noexcept -> short {
+        return _height;
+    }
+
+    auto JumpTable::Matches(const PassabilityMap& map) const noexcept -> bool {
+        return _data != nullptr && _width == map.Width() && _height == map.Height() && _fingerprint == map.Fingerprint();
+    }
+
+    auto JumpTable::Distance(const Vector2 tile, const Vector2 direction) const noexcept -> int {
+        return _data[(static_cast<std::size_t>(tile.Y) * _width + tile.X) * 8 + DirectionIndex(direction)];
+    }
+
+    auto JumpTable::Save(const std::filesystem::path& path) const noexcept -> bool {
+        if (_data == nullptr) {
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file) {
+            return false;
+        }
+
+        Header header = { { 'J', 'P', 'S', '+' }, Version, _width, _height, _fingerprint };
+
+        // Distances are written in host byte order, the file is a cache for the machine that made it
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(_data), static_cast<std::streamsize>(static_cast<std::size_t>(_width) * _height * 8 * sizeof(std::int16_t)));
+
+        return static_cast<bool>(file);
+    }
+
+    auto JumpTable::Load(const std::filesystem::path& path) noexcept -> bool {
+        MappedFile file;
+
+        if (!file.Open(path) || file.Size() < sizeof(Header)) {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, file.Data(), sizeof(header));
+
+        if (std::memcmp(header.magic, "JPS+", 4) != 0 || header.version != Version
+            || header.width < 0 || header.height < 0 || header.width > 32767 || header.height > 32767) {
+            return false;
+        }
+
+        const std::size_t count = static_cast<std::size_t>(header.width) * header.height * 8;
+
+        if (file.Size() != sizeof(Header) + count * sizeof(std::int16_t)) {
+            return false;
+        }
+
+        _width = static_cast<short>(header.width);
+        _height = static_cast<short>(header.height);
+        _fingerprint = header.fingerprint;
+        _distances.clear();
+        _file = std::move(file);
+        _data = reinterpret_cast<const std::int16_t*>(_file.Data() + sizeof(Header));
+
+        return true;
+    }
+
+    auto JumpTable::LoadOrBuild(const std::filesystem::path& path, const PassabilityMap& map) noexcept -> JumpTable {
+        JumpTable table;
+
+        if (table.Load(path) && table.Matches(map)) {
+            return table;
+        }
+
+        table = JumpTable(map);
+        table.Save(path);
+
+        return table;
+    }
+
+    auto JumpTable::DirectionIndex(const Vector2 direction) noexcept -> int {
+        if (direction.Y == 0) {
+            return direction.X < 0 ? 0 : 1;
+        }
+
+        if (direction.X == 0) {
+            return direction.Y < 0 ? 2 : 3;
+        }
+
+        return 4 + (direction.X > 0) + 2 * (direction.Y > 0);
+    }
+} // namespace AStar
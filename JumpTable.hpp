@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "MappedFile.hpp"
+#include "PassabilityMap.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Precomputed jump distances for JPS+, eight per tile in the order
+    // west, east, north, south, north-west, north-east, south-west, south-east.
+    // A positive distance is the number of steps to the next jump point in that direction,
+    // otherwise it is the negated number of steps that can be taken before hitting a wall.
+    // Tables are built once per map and can be saved to a file that is memory-mapped on load.
+    class JumpTable final {
+    public:
+        JumpTable() noexcept;
+
+        // Precomputes the jump distances of every tile in the map
+        explicit JumpTable(const PassabilityMap& map) noexcept;
+
+        JumpTable(JumpTable&& other) noexcept;
+        auto operator=(JumpTable&& other) noexcept -> JumpTable&;
+
+        [[nodiscard]] auto Width() const noexcept -> short;
+        [[nodiscard]] auto Height() const noexcept -> short;
+
+        // Checks if the table was built from a map with the same layout
+        [[nodiscard]] auto Matches(const PassabilityMap& map) const noexcept -> bool;
+
+        // Gets the jump distance from the tile in the direction
+        [[nodiscard]] auto Distance(Vector2 tile, Vector2 direction) const noexcept -> int;
+
+        // Writes the table to a file. Returns false if the file cannot be written.
+        auto Save(const std::filesystem::path& path) const noexcept -> bool;
+
+        // Memory-maps a table written by Save. Returns false if the file is missing or malformed.
+        auto Load(const std::filesystem::path& path) noexcept -> bool;
+
+        // Loads the table from the file if it matches the map, otherwise builds it and refreshes the file
+        [[nodiscard]] static auto LoadOrBuild(const std::filesystem::path& path, const PassabilityMap& map) noexcept -> JumpTable;
+
+        // Gets the slot of a direction within a tile's distances
+        [[nodiscard]] static auto DirectionIndex(Vector2 direction) noexcept -> int;
+
+    private:
+        // Leading block of a saved table
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t width;
+            std::int32_t height;
+            std::uint64_t fingerprint;
+        };
+
+        static constexpr std::uint32_t Version = 1;
+
+        short _width = 0, _height = 0;
+        std::uint64_t _fingerprint = 0;
+        std::vector<std::int16_t> _distances;
+        MappedFile _file;
+        const std::int16_t* _data = nullptr;
+    };
+} // namespace AStar
@@ -0,0 +1,329 @@
+#include "LandmarkTable.hpp"
+#include "IndexedHeap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+namespace AStar {
+    namespace {
+        // Cardinal directions first, so 4-connected searches use the leading half
+        constexpr Vector2 Directions[8] = {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+        };
+
+        // Measures the cost from the source to every tile, infinity for tiles it cannot reach
+        auto MeasureCosts(const PassabilityMap& map, const Vector2 source, const Neighbourhood neighbourhood, std::vector<double>& costs) noexcept -> void {
+            const int width = map.Width();
+            const auto count = static_cast<int>(costs.size());
+            const int directions = neighbourhood == Neighbourhood::Eight ? 8 : 4;
+
+            std::ranges::fill(costs, std::numeric_limits<double>::infinity());
+
+            IndexedHeap<double> openSet;
+            openSet.Reserve(count);
+
+            const int sourceIndex = source.Y * width + source.X;
+            costs[sourceIndex] = 0;
+            openSet.Push(sourceIndex, 0);
+
+            while (!openSet.Empty()) {
+                const int current = openSet.Pop();
+                const Vector2 tile = { static_cast<short>(current % width), static_cast<short>(current / width) };
+
+                for (int i = 0; i < directions; ++i) {
+                    const Vector2 direction = Directions[i];
+
+                    if (!map.CanMove(tile, direction)) {
+                        continue;
+                    }
+
+                    const int index = (tile.Y + direction.Y) * width + tile.X + direction.X;
+                    const double cost = costs[current] + (direction.X != 0 && direction.Y != 0 ? std::numbers::sqrt2 : 1.0);
+
+                    if (cost >= costs[index]) {
+                        continue;
+                    }
+
+                    costs[index] = cost;
+
+                    if (openSet.Contains(index)) {
+                        openSet.DecreaseKey(index, cost);
+                    }
+                    else {
+                        openSet.Push(index, cost);
+                    }
+                }
+            }
+        }
+    }
+
+    LandmarkTable::LandmarkTable() noexcept = default;
+
+    LandmarkTable::LandmarkTable(const PassabilityMap& map, const int landmarkCount, const Neighbourhood neighbourhood) noexcept
+    : _width(map.Width()), _height(map.Height()), _fingerprint(map.Fingerprint()), _neighbourhood(neighbourhood), _requestedCount(landmarkCount) {
+        const std::size_t tileCount = static_cast<std::size_t>(_width) * _height;
+
+        const auto positionOf = [this](const std::size_t index) -> Vector2 {
+            return { static_cast<short>(index % _width), static_cast<short>(index / _width) };
+        };
+
+        // Farthest point sampling: every landmark is the tile farthest from those picked before it.
+        // Tiles no landmark reaches count as farthest, so every separate region gets one.
+        // The first search only serves to find a tile on the rim of the map.
+
+        std::vector<double> costs(tileCount);
+        std::vector<double> nearest(tileCount, std::numeric_limits<double>::infinity());
+
+        const auto farthest = [&](const std::vector<double>& distances) -> std::size_t {
+            std::size_t best = tileCount;
+
+            for (std::size_t i = 0; i < tileCount; ++i) {
+                if (map.IsPassable(positionOf(i)) && (best == tileCount || distances[i] > distances[best])) {
+                    best = i;
+                }
+            }
+
+            return best;
+        };
+
+        std::size_t seed = farthest(nearest);
+
+        if (seed != tileCount) {
+            MeasureCosts(map, positionOf(seed), neighbourhood, costs);
+
+            // Only the reachable part of the seed's region decides the first landmark
+            std::ranges::replace(costs, std::numeric_limits<double>::infinity(), -1.0);
+            seed = farthest(costs);
+        }
+
+        // Costs are stored next to each other per tile, with room for every landmark asked for.
+        // Each landmark is quantized as soon as it is measured, so only one pass's costs are held at full precision.
+        const std::size_t capacity = std::min(static_cast<std::size_t>(std::max(landmarkCount, 0)), tileCount);
+        _costs.resize(tileCount * capacity);
+
+        while (seed != tileCount && _landmarks.size() < capacity) {
+            const std::size_t landmark = _landmarks.size();
+            _landmarks.push_back(positionOf(seed));
+
+            MeasureCosts(map, _landmarks.back(), neighbourhood, costs);
+            std::ranges::transform(nearest, costs, nearest.begin(), [](const double a, const double b) { return std::min(a, b); });
+
+            // Pick the unit so the longest finite cost just fits below the unreachable marker
+            double longest = 0;
+
+            for (const double cost : costs) {
+                if (cost != std::numeric_limits<double>::infinity()) {
+                    longest = std::max(longest, cost);
+                }
+            }
+
+            const double unit = longest > 0 ? longest / (Unreachable - 1) : 1;
+            _units.push_back(unit);
+
+            for (std::size_t i = 0; i < tileCount; ++i) {
+                _costs[i * capacity + landmark] = costs[i] == std::numeric_limits<double>::infinity()
+                    ? Unreachable
+                    : static_cast<std::uint16_t>(std::min(std::floor(costs[i] / unit), Unreachable - 1.0));
+            }
+
+            seed = farthest(nearest);
+
+            // Every tile is a landmark already
+            if (seed != tileCount && nearest[seed] == 0) {
+                break;
+            }
+        }
+
+        // Close the gaps left by landmarks the map had no room for, moving every tile's costs forward in place
+        const std::size_t count = _landmarks.size();
+
+        if (count < capacity) {
+            for (std::size_t i = 0; i < tileCount; ++i) {
+                std::copy_n(_costs.begin() + static_cast<std::ptrdiff_t>(i * capacity), count, _costs.begin() + static_cast<std::ptrdiff_t>(i * count));
+            }
+
+            _costs.resize(tileCount * count);
+            _costs.shrink_to_fit();
+        }
+
+        _data = _costs.data();
+    }
+
+    LandmarkTable::LandmarkTable(LandmarkTable&& other) noexcept
+    : _width(other._width), _height(other._height), _fingerprint(other._fingerprint), _neighbourhood(other._neighbourhood),
+      _requestedCount(other._requestedCount), _units(std::move(other._units)), _landmarks(std::move(other._landmarks)), _costs(std::move(other._costs)), _file(std::move(other._file)),
+      _data(std::exchange(other._data, nullptr)) {
+
+    }
+
+    auto LandmarkTable::operator=(LandmarkTable&& other) noexcept -> LandmarkTable& {
+        _width = other._width;
+        _height = other._height;
+        _fingerprint = other._fingerprint;
+        _neighbourhood = other._neighbourhood;
+        _requestedCount = other._requestedCount;
+        _units = std::move(other._units);
+        _landmarks = std::move(other._landmarks);
+        _costs = std::move(other._costs);
+        _file = std::move(other._file);
+        _data = std::exchange(other._data, nullptr);
+        return *this;
+    }
+
+    auto LandmarkTable::Width() const noexcept -> short {
+        return _width;
+    }
+
+    auto LandmarkTable::Height() const noexcept -> short {
+        return _height;
+    }
+
+    auto LandmarkTable::LandmarkCount() const noexcept -> int {
+        return static_cast<int>(_landmarks.size());
+    }
+
+    auto LandmarkTable::GetLandmark(const int landmark) const noexcept -> Vector2 {
+        return _landmarks[landmark];
+    }
+
+    auto LandmarkTable::GetNeighbourhood() const noexcept -> Neighbourhood {
+        return _neighbourhood;
+    }
+
+    auto LandmarkTable::Matches(const PassabilityMap& map) const noexcept -> bool {
+        return _data != nullptr && _width == map.Width() && _height == map.Height() && _fingerprint == map.Fingerprint();
+    }
+
+    auto LandmarkTable::EstimateDistance(const Vector2 from, const Vector2 to) const noexcept -> double {
+        const std::size_t count = _landmarks.size();
+        const std::uint16_t* fromCosts = _data + (static_cast<std::size_t>(from.Y) * _width + from.X) * count;
+        const std::uint16_t* toCosts = _data + (static_cast<std::size_t>(to.Y) * _width + to.X) * count;
+
+        // Each stored cost may be up to a unit short, so the difference can be a unit too high
+        double best = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (fromCosts[i] != Unreachable && toCosts[i] != Unreachable) {
+                best = std::max(best, (std::abs(fromCosts[i] - toCosts[i]) - 1) * _units[i]);
+            }
+        }
+
+        return best;
+    }
+
+    auto LandmarkTable::Save(const std::filesystem::path& path) const noexcept -> bool {
+        if (_data == nullptr) {
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file) {
+            return false;
+        }
+
+        // Value-initialized first, so the padding is written as zeros and equal tables give equal files
+        Header header {};
+        std::memcpy(header.magic, "ALT ", 4);
+        header.version = Version;
+        header.width = _width;
+        header.height = _height;
+        header.fingerprint = _fingerprint;
+        header.landmarkCount = LandmarkCount();
+        header.requestedCount = _requestedCount;
+        header.neighbourhood = static_cast<std::int32_t>(_neighbourhood);
+
+        std::vector<std::int16_t> landmarks;
+
+        for (const Vector2& landmark : _landmarks) {
+            landmarks.push_back(landmark.X);
+            landmarks.push_back(landmark.Y);
+        }
+
+        // Costs are written in host byte order, the file is a cache for the machine that made it
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(landmarks.data()), static_cast<std::streamsize>(landmarks.size() * sizeof(std::int16_t)));
+        file.write(reinterpret_cast<const char*>(_units.data()), static_cast<std::streamsize>(_units.size() * sizeof(double)));
+        file.write(reinterpret_cast<const char*>(_data), static_cast<std::streamsize>(static_cast<std::size_t>(_width) * _height * _landmarks.size() * sizeof(std::uint16_t)));
+
+        return static_cast<bool>(file);
+    }
+
+    auto LandmarkTable::Load(const std::filesystem::path& path) noexcept -> bool {
+        MappedFile file;
+
+        if (!file.Open(path) || file.Size() < sizeof(Header)) {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, file.Data(), sizeof(header));
+
+        if (std::memcmp(header.magic, "ALT ", 4) != 0 || header.version != Version
+            || header.width < 0 || header.height < 0 || header.width > 32767 || header.height > 32767
+            || header.landmarkCount < 0 || header.requestedCount < header.landmarkCount
+            || header.neighbourhood < 0 || header.neighbourhood > 1) {
+            return false;
+        }
+
+        const auto landmarkCount = static_cast<std::size_t>(header.landmarkCount);
+        const std::size_t landmarkBytes = landmarkCount * 2 * sizeof(std::int16_t);
+        const std::size_t unitBytes = landmarkCount * sizeof(double);
+        const std::size_t count = static_cast<std::size_t>(header.width) * header.height * landmarkCount;
+
+        if (file.Size() != sizeof(Header) + landmarkBytes + unitBytes + count * sizeof(std::uint16_t)) {
+            return false;
+        }
+
+        std::vector<std::int16_t> landmarks(landmarkCount * 2);
+        std::memcpy(landmarks.data(), file.Data() + sizeof(Header), landmarkBytes);
+
+        // Units follow the landmarks unaligned, so they are copied out rather than read in place
+        std::vector<double> units(landmarkCount);
+        std::memcpy(units.data(), file.Data() + sizeof(Header) + landmarkBytes, unitBytes);
+
+        if (!std::ranges::all_of(units, [](const double unit) { return unit > 0; })) {
+            return false;
+        }
+
+        _landmarks.clear();
+
+        for (std::size_t i = 0; i < landmarkCount; ++i) {
+            _landmarks.push_back({ landmarks[i * 2], landmarks[i * 2 + 1] });
+        }
+
+        _width = static_cast<short>(header.width);
+        _height = static_cast<short>(header.height);
+        _fingerprint = header.fingerprint;
+        _neighbourhood = static_cast<Neighbourhood>(header.neighbourhood);
+        _requestedCount = header.requestedCount;
+        _units = std::move(units);
+        _costs.clear();
+        _file = std::move(file);
+        _data = reinterpret_cast<const std::uint16_t*>(_file.Data() + sizeof(Header) + landmarkBytes + unitBytes);
+
+        return true;
+    }
+
+    auto LandmarkTable::LoadOrBuild(const std::filesystem::path& path, const PassabilityMap& map,
+        const int landmarkCount, const Neighbourhood neighbourhood) noexcept -> LandmarkTable {
+        LandmarkTable table;
+
+        // Maps with few tiles or many regions yield fewer landmarks than asked for,
+        // so the request is compared instead of the count picked
+        if (table.Load(path) && table.Matches(map) && table.GetNeighbourhood() == neighbourhood
+            && table._requestedCount == landmarkCount) {
+            return table;
+        }
+
+        table = LandmarkTable(map, landmarkCount, neighbourhood);
+        table.Save(path);
+
+        return table;
+    }
+} // namespace AStar
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "MappedFile.hpp"
+#include "PassabilityMap.hpp"
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Precomputed costs from a few landmark tiles to every tile, for the ALT heuristic.
+    // By the triangle inequality the cost between two tiles is at least the difference of their
+    // costs to any landmark, which sees around walls that straight-line distances cannot.
+    // Costs are stored as 16-bit multiples of a unit per landmark chosen to fit its longest one, rounded down,
+    // so estimates subtract one unit to stay admissible.
+    // Tables are built once per map and can be saved to a file that is memory-mapped on load.
+    class LandmarkTable final {
+    public:
+        LandmarkTable() noexcept;
+
+        // Picks the landmarks spread as far apart as possible and measures the costs from each.
+        // Costs measured with diagonal moves also bound 4-connected searches, but not the other way round.
+        LandmarkTable(const PassabilityMap& map, int landmarkCount, Neighbourhood neighbourhood = Neighbourhood::Eight) noexcept;
+
+        LandmarkTable(LandmarkTable&& other) noexcept;
+        auto operator=(LandmarkTable&& other) noexcept -> LandmarkTable&;
+
+        [[nodiscard]] auto Width() const noexcept -> short;
+        [[nodiscard]] auto Height() const noexcept -> short;
+        [[nodiscard]] auto LandmarkCount() const noexcept -> int;
+        [[nodiscard]] auto GetLandmark(int landmark) const noexcept -> Vector2;
+        [[nodiscard]] auto GetNeighbourhood() const noexcept -> Neighbourhood;
+
+        // Checks if the table was built from a map with the same layout
+        [[nodiscard]] auto Matches(const PassabilityMap& map) const noexcept -> bool;
+
+        // Gets a lower bound on the cost of moving between the tiles
+        [[nodiscard]] auto EstimateDistance(Vector2 from, Vector2 to) const noexcept -> double;
+
+        // Writes the table to a file. Returns false if the file cannot be written.
+        auto Save(const std::filesystem::path& path) const noexcept -> bool;
+
+        // Memory-maps a table written by Save. Returns false if the file is missing or malformed.
+        auto Load(const std::filesystem::path& path) noexcept -> bool;
+
+        // Loads the table from the file if it matches the map and settings, otherwise builds it and refreshes the file
+        [[nodiscard]] static auto LoadOrBuild(const std::filesystem::path& path, const PassabilityMap& map,
+            int landmarkCount, Neighbourhood neighbourhood = Neighbourhood::Eight) noexcept -> LandmarkTable;
+
+    private:
+        // Leading block of a saved table, followed by the landmarks, their units and then the costs
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t width;
+            std::int32_t height;
+            std::uint64_t fingerprint;
+            std::int32_t landmarkCount;
+            std::int32_t requestedCount;
+            std::int32_t neighbourhood;
+        };
+
+        static constexpr std::uint32_t Version = 3;
+
+        // Stored for tiles a landmark cannot reach
+        static constexpr std::uint16_t Unreachable = 0xFFFF;
+
+        short _width = 0, _height = 0;
+        std::uint64_t _fingerprint = 0;
+        Neighbourhood _neighbourhood = Neighbourhood::Eight;
+        int _requestedCount = 0; // Landmarks asked for, more than were picked if the map has too few regions or tiles
+        std::vector<double> _units; // Cost of one step of each landmark's stored costs
+        std::vector<Vector2> _landmarks;
+        std::vector<std::uint16_t> _costs; // Every tile's costs to all landmarks next to each other
+        MappedFile _file;
+        const std::uint16_t* _data = nullptr;
+    };
+} // namespace AStar
@@ -0,0 +1,431 @@
+#include "MapGenerator.hpp"
+#include "Arithmetic.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace AStar {
+    namespace {
+        // SplitMix64, small and fully specified, unlike the distributions of the standard library
+        class Random final {
+        public:
+            explicit Random(const std::uint64_t seed) noexcept : _state(seed) {
+
+            }
+
+            auto Next() noexcept -> std::uint64_t {
+                std::uint64_t value = _state += 0x9E3779B97F4A7C15ull;
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+                return value ^ (value >> 31);
+            }
+
+            // Uniform in [0, count), for counts below 2^32, with integers only so rounding cannot differ anywhere
+            auto Below(const std::uint64_t count) noexcept -> std::uint64_t {
+                return ((Next() >> 32) * count) >> 32;
+            }
+
+            // Draws whether an event with the given odds happens
+            auto Happens(const std::uint64_t odds) noexcept -> bool {
+                return (Next() >> 11) < odds;
+            }
+
+            // Probability as a number of chances in 2^53. Scaling by a power of two is exact,
+            // so every platform turns it into the same whole number.
+            static auto Odds(const double probability) noexcept -> std::uint64_t {
+                if (!(probability > 0)) {
+                    return 0;
+                }
+
+                return probability >= 1 ? 1ull << 53 : static_cast<std::uint64_t>(std::ceil(probability * 0x1p53));
+            }
+
+        private:
+            std::uint64_t _state;
+        };
+
+        auto BlockedGrid(const Vector2 dimensions) noexcept -> Grid {
+            Grid grid(dimensions, {});
+
+            for (short y = 0; y < dimensions.Y; ++y) {
+                for (short x = 0; x < dimensions.X; ++x) {
+                    grid.SetObstacle({ x, y });
+                }
+            }
+
+            return grid;
+        }
+
+        // Opens every tile of the rectangle between the corners, both included
+        auto Carve(Grid& grid, const Vector2 from, const Vector2 to) noexcept -> void {
+            for (short y = std::min(from.Y, to.Y); y <= std::max(from.Y, to.Y); ++y) {
+                for (short x = std::min(from.X, to.X); x <= std::max(from.X, to.X); ++x) {
+                    grid.ClearObstacle({ x, y });
+                }
+            }
+        }
+
+        // Exact rotation, turning (x, y) into (x * cosine + y * sine, y * cosine - x * sine) / hypotenuse
+        struct Rotation {
+            long long cosine, sine, hypotenuse;
+        };
+
+        // Rotation with its angle in degrees, rounded to two places
+        struct Turn {
+            double degrees;
+            Rotation rotation;
+        };
+
+        // Rotations up to 45 degrees whose cosine and sine are ratios of whole numbers, from the primitive
+        // Pythagorean triples with a hypotenuse up to 100, so a turned street grid needs no trigonometry at all.
+        // No two neighbours lie more than 9 degrees apart.
+        constexpr Turn Turns[] = {
+            { 0.0, { 1, 0, 1 } },
+            { 8.80, { 84, 13, 85 } },
+            { 10.39, { 60, 11, 61 } },
+            { 12.68, { 40, 9, 41 } },
+            { 14.25, { 63, 16, 65 } },
+            { 16.26, { 24, 7, 25 } },
+            { 18.92, { 35, 12, 37 } },
+            { 22.62, { 12, 5, 13 } },
+            { 25.06, { 77, 36, 85 } },
+            { 25.99, { 80, 39, 89 } },
+            { 28.07, { 15, 8, 17 } },
+            { 30.51, { 56, 33, 65 } },
+            { 31.89, { 45, 28, 53 } },
+            { 36.87, { 4, 3, 5 } },
+            { 41.11, { 55, 48, 73 } },
+            { 42.08, { 72, 65, 97 } },
+            { 43.60, { 21, 20, 29 } }
+        };
+
+        static_assert(std::ranges::all_of(Turns, [](const Turn& turn) {
+            const auto [cosine, sine, hypotenuse] = turn.rotation;
+            return cosine * cosine + sine * sine == hypotenuse * hypotenuse && sine <= cosine;
+        }), "every turn must be a rotation of at most 45 degrees");
+
+        static_assert(std::ranges::adjacent_find(Turns, [](const Turn& turn, const Turn& next) {
+            return next.degrees <= turn.degrees || next.rotation.sine * turn.rotation.cosine <= turn.rotation.sine * next.rotation.cosine;
+        }) == std::ranges::end(Turns), "turns must be sorted by their angles and by their slopes alike");
+
+        // Gets the exact rotation closest to the angle in degrees. Reducing the angle only takes
+        // exact steps and the turns above 45 degrees mirror those below it, so it snaps the same everywhere.
+        auto Nearest(const double angle) noexcept -> Rotation {
+            double remaining = std::isfinite(angle) ? std::fmod(angle, 360.0) : 0;
+            int quarters = 0;
+
+            if (remaining < 0) {
+                remaining += 360;
+            }
+
+            while (remaining >= 90) {
+                remaining -= 90;
+                ++quarters;
+            }
+
+            const bool mirrored = remaining > 45;
+            const double target = mirrored ? 90 - remaining : remaining;
+
+            const Turn& nearest = *std::ranges::min_element(Turns, {}, [target](const Turn& turn) {
+                return std::abs(turn.degrees - target);
+            });
+
+            // Mirroring about 45 degrees swaps the cosine and sine, each quarter turn takes (c, s) to (-s, c)
+            Rotation rotation = nearest.rotation;
+
+            if (mirrored) {
+                std::swap(rotation.cosine, rotation.sine);
+            }
+
+            for (int i = 0; i < quarters % 4; ++i) {
+                rotation = { -rotation.sine, rotation.cosine, rotation.hypotenuse };
+            }
+
+            return rotation;
+        }
+    }
+
+    auto MapGenerator::RandomObstacles(const Vector2 dimensions, const double density, const std::uint64_t seed) noexcept -> Grid {
+        Grid grid(dimensions, {});
+        Random random(seed);
+        const std::uint64_t odds = Random::Odds(density);
+
+        for (short y = 0; y < dimensions.Y; ++y) {
+            for (short x = 0; x < dimensions.X; ++x) {
+                if (random.Happens(odds)) {
+                    grid.SetObstacle({ x, y });
+                }
+            }
+        }
+
+        return grid;
+    }
+
+    auto MapGenerator::RecursiveDivision(const Vector2 dimensions, const std::uint64_t seed) noexcept -> Grid {
+        Grid grid(dimensions, {});
+        Random random(seed);
+
+        if (dimensions.X <= 0 || dimensions.Y <= 0) {
+            return grid;
+        }
+
+        // A trailing odd column or row has no passage to serve, so it is walled off
+        const auto lastX = static_cast<short>((dimensions.X - 1) & ~1);
+        const auto lastY = static_cast<short>((dimensions.Y - 1) & ~1);
+
+        if (lastX + 1 < dimensions.X) {
+            for (short y = 0; y < dimensions.Y; ++y) {
+                grid.SetObstacle({ static_cast<short>(lastX + 1), y });
+            }
+        }
+
+        if (lastY + 1 < dimensions.Y) {
+            for (short x = 0; x < dimensions.X; ++x) {
+                grid.SetObstacle({ x, static_cast<short>(lastY + 1) });
+            }
+        }
+
+        // Chambers still to be split, kept on a stack so huge maps cannot overflow the call stack.
+        // Corners lie on even coordinates, so walls go on the odd ones between them.
+
+        struct Chamber {
+            short x0, y0, x1, y1;
+        };
+
+        std::vector<Chamber> chambers { { 0, 0, lastX, lastY } };
+
+        while (!chambers.empty()) {
+            const Chamber chamber = chambers.back();
+            chambers.pop_back();
+
+            const int width = chamber.x1 - chamber.x0;
+            const int height = chamber.y1 - chamber.y0;
+
+            if (width < 2 && height < 2) {
+                continue;
+            }
+
+            // Splitting across the longer side keeps chambers from turning into long strips
+            if (width > height || (width == height && random.Below(2) == 0)) {
+                const auto wall = static_cast<short>(chamber.x0 + 1 + 2 * random.Below(width / 2));
+                const auto gap = static_cast<short>(chamber.y0 + 2 * random.Below(height / 2 + 1));
+
+                for (short y = chamber.y0; y <= chamber.y1; ++y) {
+                    if (y != gap) {
+                        grid.SetObstacle({ wall, y });
+                    }
+                }
+
+                chambers.push_back({ chamber.x0, chamber.y0, static_cast<short>(wall - 1), chamber.y1 });
+                chambers.push_back({ static_cast<short>(wall + 1), chamber.y0, chamber.x1, chamber.y1 });
+            }
+            else {
+                const auto wall = static_cast<short>(chamber.y0 + 1 + 2 * random.Below(height / 2));
+                const auto gap = static_cast<short>(chamber.x0 + 2 * random.Below(width / 2 + 1));
+
+                for (short x = chamber.x0; x <= chamber.x1; ++x) {
+                    if (x != gap) {
+                        grid.SetObstacle({ x, wall });
+                    }
+                }
+
+                chambers.push_back({ chamber.x0, chamber.y0, chamber.x1, static_cast<short>(wall - 1) });
+                chambers.push_back({ chamber.x0, static_cast<short>(wall + 1), chamber.x1, chamber.y1 });
+            }
+        }
+
+        return grid;
+    }
+
+    auto MapGenerator::DepthFirstMaze(const Vector2 dimensions, const std::uint64_t seed) noexcept -> Grid {
+        Grid grid = BlockedGrid(dimensions);
+        Random random(seed);
+
+        if (dimensions.X <= 0 || dimensions.Y <= 0) {
+            return grid;
+        }
+
+        // Cells sit on even coordinates and a cell is visited once it is open,
+        // so the grid itself tracks the walk and the stack is the only extra memory
+
+        const PassabilityMap& passability = grid.GetPassability();
+        std::vector<Vector2> stack { { 0, 0 } };
+        grid.ClearObstacle({ 0, 0 });
+
+        while (!stack.empty()) {
+            const Vector2 cell = stack.back();
+
+            std::array<Vector2, 4> unvisited;
+            int count = 0;
+
+            for (const Vector2 step : { Vector2{ -2, 0 }, Vector2{ 2, 0 }, Vector2{ 0, -2 }, Vector2{ 0, 2 } }) {
+                const Vector2 next = { static_cast<short>(cell.X + step.X), static_cast<short>(cell.Y + step.Y) };
+
+                if (next.X >= 0 && next.X < dimensions.X && next.Y >= 0 && next.Y < dimensions.Y && !passability.IsPassable(next)) {
+                    unvisited[count++] = next;
+                }
+            }
+
+            if (count == 0) {
+                stack.pop_back();
+                continue;
+            }
+
+            // Knock down the wall between the cells and walk on
+            const Vector2 next = unvisited[random.Below(count)];
+            grid.ClearObstacle({ static_cast<short>((cell.X + next.X) / 2), static_cast<short>((cell.Y + next.Y) / 2) });
+            grid.ClearObstacle(next);
+            stack.push_back(next);
+        }
+
+        return grid;
+    }
+
+    auto MapGenerator::Caves(const Vector2 dimensions, const std::uint64_t seed, const double fill, const int passes) noexcept -> Grid {
+        Random random(seed);
+
+        const int width = std::max<int>(dimensions.X, 0);
+        const int height = std::max<int>(dimensions.Y, 0);
+
+        std::vector<std::uint8_t> blocked(static_cast<std::size_t>(width) * height);
+        std::vector<std::uint8_t> next(blocked.size());
+        const std::uint64_t odds = Random::Odds(fill);
+
+        for (std::uint8_t& tile : blocked) {
+            tile = random.Happens(odds);
+        }
+
+        // Tiles beyond the edges count as blocked, which closes the caves off at the border
+        const auto isBlocked = [&](const int x, const int y) -> int {
+            return x < 0 || x >= width || y < 0 || y >= height || blocked[static_cast<std::size_t>(y) * width + x];
+        };
+
+        for (int pass = 0; pass < passes; ++pass) {
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    int walls = 0;
+
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            walls += isBlocked(x + dx, y + dy);
+                        }
+                    }
+
+                    next[static_cast<std::size_t>(y) * width + x] = walls >= 5;
+                }
+            }
+
+            blocked.swap(next);
+        }
+
+        Grid grid(dimensions, {});
+
+        for (short y = 0; y < height; ++y) {
+            for (short x = 0; x < width; ++x) {
+                if (blocked[static_cast<std::size_t>(y) * width + x]) {
+                    grid.SetObstacle({ x, y });
+                }
+            }
+        }
+
+        return grid;
+    }
+
+    auto MapGenerator::RoomsAndCorridors(const Vector2 dimensions, const std::uint64_t seed, const int roomCount,
+        const short minimumRoomSize, const short maximumRoomSize) noexcept -> Grid {
+        Grid grid = BlockedGrid(dimensions);
+        Random random(seed);
+
+        struct Room {
+            short x0, y0, x1, y1;
+        };
+
+        std::vector<Room> rooms;
+
+        // Rooms keep one wall tile between them, and give up on a spot after a few tries
+        // rather than looping forever on a crowded map
+        const short minimum = std::max<short>(minimumRoomSize, 1);
+        const short maximum = std::max(minimum, maximumRoomSize);
+
+        for (int attempt = 0; attempt < roomCount * 8 && static_cast<int>(rooms.size()) < roomCount; ++attempt) {
+            const auto width = static_cast<short>(minimum + random.Below(maximum - minimum + 1));
+            const auto height = static_cast<short>(minimum + random.Below(maximum - minimum + 1));
+
+            if (width > dimensions.X - 2 || height > dimensions.Y - 2) {
+                continue;
+            }
+
+            const auto x = static_cast<short>(1 + random.Below(dimensions.X - width - 1));
+            const auto y = static_cast<short>(1 + random.Below(dimensions.Y - height - 1));
+            const Room room = { x, y, static_cast<short>(x + width - 1), static_cast<short>(y + height - 1) };
+
+            const bool overlaps = std::ranges::any_of(rooms, [&room](const Room& other) {
+                return room.x0 <= other.x1 + 1 && other.x0 <= room.x1 + 1 && room.y0 <= other.y1 + 1 && other.y0 <= room.y1 + 1;
+            });
+
+            if (overlaps) {
+                continue;
+            }
+
+            Carve(grid, { room.x0, room.y0 }, { room.x1, room.y1 });
+
+            // Every room links to the one before it, so all of them end up connected
+            if (!rooms.empty()) {
+                const Room& previous = rooms.back();
+                const Vector2 from = { static_cast<short>((previous.x0 + previous.x1) / 2), static_cast<short>((previous.y0 + previous.y1) / 2) };
+                const Vector2 to = { static_cast<short>((room.x0 + room.x1) / 2), static_cast<short>((room.y0 + room.y1) / 2) };
+                const Vector2 corner = random.Below(2) == 0 ? Vector2{ to.X, from.Y } : Vector2{ from.X, to.Y };
+
+                Carve(grid, from, corner);
+                Carve(grid, corner, to);
+            }
+
+            rooms.push_back(room);
+        }
+
+        return grid;
+    }
+
+    auto MapGenerator::CityBlocks(const Vector2 dimensions, const std::uint64_t seed, const short blockSize,
+        const short streetWidth, const double angle, const double parkShare) noexcept -> Grid {
+        Grid grid(dimensions, {});
+
+        const auto [cosine, sine, hypotenuse] = Nearest(angle);
+        const std::uint64_t parkOdds = Random::Odds(parkShare);
+
+        // Positions are measured in half tiles from the centre of the map, so tile centres fall on whole numbers.
+        // Rotated positions come out scaled by the hypotenuse, so the street grid is scaled to match.
+        const long long period = 2 * hypotenuse * (std::max(blockSize, short{ 1 }) + std::max(streetWidth, short{ 1 }));
+        const long long building = 2 * hypotenuse * blockSize;
+
+        // Turns each tile centre into street grid coordinates and checks which block it falls in.
+        // Whether a block is a park is hashed from its position, so it needs no memory.
+
+        for (short y = 0; y < dimensions.Y; ++y) {
+            for (short x = 0; x < dimensions.X; ++x) {
+                const long long offsetX = 2ll * x + 1 - dimensions.X;
+                const long long offsetY = 2ll * y + 1 - dimensions.Y;
+                const long long u = offsetX * cosine + offsetY * sine;
+                const long long v = offsetY * cosine - offsetX * sine;
+
+                const long long blockU = FloorDivide(u, period);
+                const long long blockV = FloorDivide(v, period);
+
+                if (u - blockU * period >= building || v - blockV * period >= building) {
+                    continue;
+                }
+
+                Random block(seed ^ static_cast<std::uint64_t>(blockU) * 0x9E3779B97F4A7C15ull
+                    ^ static_cast<std::uint64_t>(blockV) * 0xC2B2AE3D27D4EB4Full);
+
+                if (!block.Happens(parkOdds)) {
+                    grid.SetObstacle({ x, y });
+                }
+            }
+        }
+
+        return grid;
+    }
+} // namespace AStar
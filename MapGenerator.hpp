@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include "Grid.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Seeded generators of synthetic maps for stress and scaling tests.
+    // Each one draws from its own generator with a fixed algorithm, so a seed gives the same map
+    // on every platform and standard library. All of them stream over the tiles with memory
+    // linear in the map size, so maps of tens of millions of tiles are generated in seconds.
+    class MapGenerator final {
+    public:
+        // Blocks every tile independently with the probability given by the density
+        [[nodiscard]] static auto RandomObstacles(Vector2 dimensions, double density, std::uint64_t seed) noexcept -> Grid;
+
+        // Perfect maze made by splitting the map with walls that each keep a single gap.
+        // Passages run along even coordinates, walls along odd ones.
+        [[nodiscard]] static auto RecursiveDivision(Vector2 dimensions, std::uint64_t seed) noexcept -> Grid;
+
+        // Perfect maze carved by a randomized depth-first walk, with long winding corridors.
+        // Passages run along even coordinates, walls along odd ones.
+        [[nodiscard]] static auto DepthFirstMaze(Vector2 dimensions, std::uint64_t seed) noexcept -> Grid;
+
+        // Caves grown from random noise by a cellular automaton. Every smoothing pass blocks a tile
+        // when at least five of the nine tiles around and including it are blocked.
+        [[nodiscard]] static auto Caves(Vector2 dimensions, std::uint64_t seed, double fill = 0.45, int passes = 4) noexcept -> Grid;
+
+        // Rectangular rooms placed without overlapping and chained together by L-shaped corridors
+        [[nodiscard]] static auto RoomsAndCorridors(Vector2 dimensions, std::uint64_t seed, int roomCount = 64,
+            short minimumRoomSize = 4, short maximumRoomSize = 16) noexcept -> Grid;
+
+        // Square buildings separated by streets, in a street grid turned by the angle in degrees.
+        // The angle snaps to the nearest of a fixed set of rotations with exact whole number ratios, at most 4.4 degrees off.
+        // Some blocks are left empty as squares, as many as the park share says.
+        [[nodiscard]] static auto CityBlocks(Vector2 dimensions, std::uint64_t seed, short blockSize = 12,
+            short streetWidth = 3, double angle = 30, double parkShare = 0.1) noexcept -> Grid;
+    };
+} // namespace AStar
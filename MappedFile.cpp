@@ -0,0 +1,121 @@
+#include "MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AStar {
+    MappedFile::MappedFile() noexcept = default;
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) {
+
+    }
+
+    auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+        if (this != &other) {
+            Close();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile() noexcept {
+        Close();
+    }
+
+    auto MappedFile::Open(const std::filesystem::path& path) noexcept -> bool {
+        Close();
+
+#ifdef _WIN32
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        // The view keeps the mapping alive, so both handles can be closed right away
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (mapping == nullptr) {
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (view == nullptr) {
+            return false;
+        }
+
+        _data = static_cast<const std::byte*>(view);
+        _size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+
+        if (file == -1) {
+            return false;
+        }
+
+        struct stat status {};
+
+        if (fstat(file, &status) == -1 || status.st_size == 0) {
+            close(file);
+            return false;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        _data = static_cast<const std::byte*>(view);
+        _size = static_cast<std::size_t>(status.st_size);
+#endif
+
+        return true;
+    }
+
+    auto MappedFile::Close() noexcept -> void {
+        if (_data == nullptr) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap(const_cast<std::byte*>(_data), _size);
+#endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+
+    auto MappedFile::Data() const noexcept -> const std::byte* {
+        return _data;
+    }
+
+    auto MappedFile::Size() const noexcept -> std::size_t {
+        return _size;
+    }
+} // namespace AStar
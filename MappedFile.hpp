@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace AStar {
+    // Read-only memory mapping of a whole file
+    class MappedFile final {
+    public:
+        MappedFile() noexcept;
+        MappedFile(MappedFile&& other) noexcept;
+        auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+        ~MappedFile() noexcept;
+
+        MappedFile(const MappedFile&) = delete;
+        auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+        // Maps the file, replacing any previous mapping. Returns false if the file cannot be mapped.
+        auto Open(const std::filesystem::path& path) noexcept -> bool;
+
+        // Unmaps the file
+        auto Close() noexcept -> void;
+
+        [[nodiscard]] auto Data() const noexcept -> const std::byte*;
+        [[nodiscard]] auto Size() const noexcept -> std::size_t;
+
+    private:
+        const std::byte* _data = nullptr;
+        std::size_t _size = 0;
+    };
+} // namespace AStar
@@ -0,0 +1,266 @@
+#include "BucketQueue.hpp"
+#include "Grid.hpp"
+#include "IndexedHeap.hpp"
+#include "MapGenerator.hpp"
+#include "Pathfinder.hpp"
+#include "SearchPolicies.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace AStar;
+
+namespace {
+    // Settings taken from the command line
+    struct Settings {
+        bool json = false;
+        int repeats = 5;
+        int maxSize = 2048;
+    };
+
+    // Timing of one hot path on one grid
+    struct Measurement {
+        std::string_view name;
+        int size;
+        int density;
+        std::size_t operations; // Per repeat
+        double medianNanoseconds; // Per operation
+        double minimumNanoseconds;
+    };
+
+    // Keeps results alive so the measured work is not optimized away
+    volatile std::size_t sink = 0;
+
+    // Fills a square grid with obstacles at the density in percent, keeping the corners open.
+    // The seed is fixed so every run and every machine measures the same grids.
+    auto MakeGrid(const int size, const int density) -> std::shared_ptr<const Grid> {
+        const Vector2 dimensions = { static_cast<short>(size), static_cast<short>(size) };
+        Grid grid = MapGenerator::RandomObstacles(dimensions, density / 100.0, static_cast<std::uint64_t>(size) * 100 + density);
+
+        grid.ClearObstacle({ 0, 0 });
+        grid.ClearObstacle({ static_cast<short>(size - 1), static_cast<short>(size - 1) });
+
+        return std::make_shared<const Grid>(std::move(grid));
+    }
+
+    // Runs the work the set number of times, each run returning how many operations it did.
+    // The preparation runs untimed before every run.
+    auto Measure(const Settings& settings, const std::string_view name, const int size, const int density,
+        const std::function<std::size_t()>& work, const std::function<void()>& prepare = {}) -> Measurement {
+        std::vector<double> perOperation;
+        std::size_t operations = 0;
+
+        for (int i = 0; i < settings.repeats; ++i) {
+            if (prepare) {
+                prepare();
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            operations = work();
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+
+            perOperation.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(std::max<std::size_t>(operations, 1)));
+        }
+
+        std::ranges::sort(perOperation);
+        return { name, size, density, operations, perOperation[perOperation.size() / 2], perOperation.front() };
+    }
+
+    // Pushes every tile with keys rising like A* scores and pops them all, one pop for every two pushes
+    template<typename OpenSet>
+    auto PushPop(OpenSet& openSet, const int count) -> std::size_t {
+        std::mt19937 random(1);
+        typename OpenSet::Priority base = 0;
+        std::size_t popped = 0;
+
+        openSet.Reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            openSet.Push(i, base + static_cast<typename OpenSet::Priority>(random() % 64));
+
+            if (i % 2 == 1) {
+                base = openSet.TopPriority();
+                popped += openSet.Pop();
+            }
+        }
+
+        while (!openSet.Empty()) {
+            popped += openSet.Pop();
+        }
+
+        sink = sink + popped;
+        return static_cast<std::size_t>(count) * 2;
+    }
+
+    auto MeasureGrid(const Settings& settings, const int size, const int density, std::vector<Measurement>& results) -> void {
+        const auto grid = MakeGrid(size, density);
+        const PassabilityMap& passability = grid->GetPassability();
+        const int count = size * size;
+        const Vector2 start = { 0, 0 };
+        const Vector2 end = { static_cast<short>(size - 1), static_cast<short>(size - 1) };
+
+        results.push_back(Measure(settings, "heap_push_pop", size, density, [&] {
+            IndexedHeap<double> openSet;
+            return PushPop(openSet, count);
+        }));
+
+        results.push_back(Measure(settings, "buckets_push_pop", size, density, [&] {
+            BucketQueue openSet;
+            return PushPop(openSet, count);
+        }));
+
+        results.push_back(Measure(settings, "can_move", size, density, [&] {
+            std::size_t open = 0;
+
+            for (short y = 0; y < size; ++y) {
+                for (short x = 0; x < size; ++x) {
+                    for (const Vector2& direction : EightConnected::Directions) {
+                        open += passability.CanMove({ x, y }, direction);
+                    }
+                }
+            }
+
+            sink = sink + open;
+            return static_cast<std::size_t>(count) * EightConnected::Directions.size();
+        }));
+
+        results.push_back(Measure(settings, "octile_distance", size, density, [&] {
+            double total = 0;
+
+            for (short y = 0; y < size; ++y) {
+                for (short x = 0; x < size; ++x) {
+                    total += OctileDistance::Estimate<ExactUnits>({ x, y }, end);
+                }
+            }
+
+            sink = sink + static_cast<std::size_t>(total);
+            return static_cast<std::size_t>(count);
+        }));
+
+        results.push_back(Measure(settings, "line_of_sight", size, density, [&] {
+            std::mt19937 random(2);
+            std::size_t visible = 0;
+            constexpr std::size_t Lines = 10000;
+
+            for (std::size_t i = 0; i < Lines; ++i) {
+                const Vector2 from = { static_cast<short>(random() % size), static_cast<short>(random() % size) };
+                const Vector2 to = { static_cast<short>(random() % size), static_cast<short>(random() % size) };
+                visible += passability.HasLineOfSight(from, to);
+            }
+
+            sink = sink + visible;
+            return Lines;
+        }));
+
+        // Node stores are allocated by the first search, so only the generation reset is timed
+        Pathfinder pathfinder(grid, { .neighbourhood = Neighbourhood::Eight });
+        pathfinder.Initialize(start, end);
+
+        results.push_back(Measure(settings, "initialize", size, density, [&] {
+            constexpr std::size_t Calls = 1000;
+
+            for (std::size_t i = 0; i < Calls; ++i) {
+                pathfinder.Initialize(i % 2 == 0 ? start : end, i % 2 == 0 ? end : start);
+            }
+
+            return Calls;
+        }));
+
+        pathfinder.Initialize(start, end);
+        const Pathfinder::Progress search = pathfinder.Update(Pathfinder::Budget{});
+
+        if (search.status == Pathfinder::Status::Success) {
+            // The search is solved already, so only the rebuild from the parent links is timed
+            results.push_back(Measure(settings, "reconstruct_path", size, density, [&] {
+                pathfinder.RebuildPath();
+                return pathfinder.GetPath().size();
+            }));
+
+            // Searching up to the last expansion leaves the final step, which pops the end tile off the open list
+            // and rebuilds the path, as a search finishing under Update pays for both
+            results.push_back(Measure(settings, "final_pop_and_reconstruct_path", size, density, [&] {
+                pathfinder.Update();
+                return pathfinder.GetPath().size();
+            }, [&] {
+                pathfinder.Initialize(start, end);
+                pathfinder.Update(Pathfinder::Budget{ .maxExpansions = search.totalExpansions - 1 });
+            }));
+
+            results.push_back(Measure(settings, "find_path", size, density, [&] {
+                sink = sink + pathfinder.FindPath(start, end).path.size();
+                return std::size_t{ 1 };
+            }));
+        }
+    }
+
+    auto PrintCsv(const std::vector<Measurement>& results) -> void {
+        std::printf("benchmark,size,density,operations,median_ns_per_op,min_ns_per_op\n");
+
+        for (const Measurement& result : results) {
+            std::printf("%.*s,%d,%d,%zu,%.3f,%.3f\n", static_cast<int>(result.name.size()), result.name.data(),
+                result.size, result.density, result.operations, result.medianNanoseconds, result.minimumNanoseconds);
+        }
+    }
+
+    auto PrintJson(const std::vector<Measurement>& results) -> void {
+        std::printf("{\n  \"benchmarks\": [\n");
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Measurement& result = results[i];
+
+            std::printf("    { \"benchmark\": \"%.*s\", \"size\": %d, \"density\": %d, \"operations\": %zu, "
+                "\"median_ns_per_op\": %.3f, \"min_ns_per_op\": %.3f }%s\n",
+                static_cast<int>(result.name.size()), result.name.data(), result.size, result.density, result.operations,
+                result.medianNanoseconds, result.minimumNanoseconds, i + 1 < results.size() ? "," : "");
+        }
+
+        std::printf("  ]\n}\n");
+    }
+}
+
+// Times the hot paths of the search one by one on seeded square grids of rising size and obstacle density.
+// Results go to standard output as CSV, or JSON with --json, in a fixed order so runs can be diffed.
+int main(const int argc, char** argv) {
+    Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--json") {
+            settings.json = true;
+        }
+        else if (argument == "--repeats" && i + 1 < argc) {
+            settings.repeats = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (argument == "--max-size" && i + 1 < argc) {
+            settings.maxSize = std::atoi(argv[++i]);
+        }
+        else {
+            std::fprintf(stderr, "Usage: MicroBenchmark [--json] [--repeats <count>] [--max-size <tiles>]\n");
+            return 2;
+        }
+    }
+
+    std::vector<Measurement> results;
+
+    for (int size = 64; size <= settings.maxSize && size <= 32767; size *= 2) {
+        for (const int density : { 0, 10, 20, 30 }) {
+            MeasureGrid(settings, size, density, results);
+        }
+    }
+
+    if (settings.json) {
+        PrintJson(results);
+    }
+    else {
+        PrintCsv(results);
+    }
+
+    return 0;
+}
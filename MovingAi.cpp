@@ -0,0 +1,102 @@
+#include "MovingAi.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace AStar {
+    auto MovingAi::LoadMap(const std::filesystem::path& path, Grid& grid) noexcept -> bool {
+        std::ifstream file(path);
+
+        if (!file) {
+            return false;
+        }
+
+        // The header names the dimensions in any order and ends with the line "map"
+
+        int width = -1, height = -1;
+        std::string key;
+
+        while (file >> key && key != "map") {
+            if (key == "type") {
+                file >> key;
+            }
+            else if (key == "width") {
+                file >> width;
+            }
+            else if (key == "height") {
+                file >> height;
+            }
+            else {
+                return false;
+            }
+        }
+
+        if (!file || width <= 0 || height <= 0 || width > 32767 || height > 32767) {
+            return false;
+        }
+
+        Grid loaded({ static_cast<short>(width), static_cast<short>(height) }, {});
+        std::string row;
+
+        std::getline(file, row);
+
+        for (short y = 0; y < height; ++y) {
+            if (!std::getline(file, row) || row.size() < static_cast<std::size_t>(width)) {
+                return false;
+            }
+
+            for (short x = 0; x < width; ++x) {
+                const char tile = row[x];
+
+                if (tile != '.' && tile != 'G' && tile != 'S') {
+                    loaded.SetObstacle({ x, y });
+                }
+            }
+        }
+
+        grid = std::move(loaded);
+        return true;
+    }
+
+    auto MovingAi::LoadScenarios(const std::filesystem::path& path, std::vector<Scenario>& scenarios) noexcept -> bool {
+        std::ifstream file(path);
+
+        if (!file) {
+            return false;
+        }
+
+        std::vector<Scenario> loaded;
+        std::string line;
+
+        while (std::getline(file, line)) {
+            if (line.starts_with("version") || line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            Scenario scenario;
+            std::string map;
+            int width, height, startX, startY, endX, endY;
+
+            if (!(fields >> scenario.bucket >> map >> width >> height >> startX >> startY >> endX >> endY >> scenario.optimalLength)) {
+                return false;
+            }
+
+            // Every tile has to lie on a map of the size named
+            if (width <= 0 || height <= 0 || width > 32767 || height > 32767
+                || startX < 0 || startX >= width || startY < 0 || startY >= height
+                || endX < 0 || endX >= width || endY < 0 || endY >= height) {
+                return false;
+            }
+
+            scenario.map = map;
+            scenario.dimensions = { static_cast<short>(width), static_cast<short>(height) };
+            scenario.start = { static_cast<short>(startX), static_cast<short>(startY) };
+            scenario.end = { static_cast<short>(endX), static_cast<short>(endY) };
+            loaded.push_back(std::move(scenario));
+        }
+
+        scenarios.insert(scenarios.end(), loaded.begin(), loaded.end());
+        return true;
+    }
+} // namespace AStar
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include "Grid.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // One query of a Moving AI scenario file
+    struct Scenario {
+        int bucket;                // Group of queries with similar optimal lengths
+        std::filesystem::path map; // Map file as named in the scenario file
+        Vector2 dimensions;        // Size the map is expected to have
+        Vector2 start;
+        Vector2 end;
+        double optimalLength;      // 8-connected with diagonals of length square root of two and no corners cut
+    };
+
+    // Readers for the grid benchmark formats of the Moving AI Lab
+    class MovingAi final {
+    public:
+        // Reads an octile .map file. '.', 'G' and 'S' tiles are passable, every other tile is blocked.
+        // Returns false if the file is missing or malformed, leaving the grid unchanged.
+        static auto LoadMap(const std::filesystem::path& path, Grid& grid) noexcept -> bool;
+
+        // Reads the queries of a .scen file, with or without the version line, appending them to the list.
+        // Returns false if the file is missing or malformed, leaving the list unchanged.
+        static auto LoadScenarios(const std::filesystem::path& path, std::vector<Scenario>& scenarios) noexcept -> bool;
+    };
+} // namespace AStar
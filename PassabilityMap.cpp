@@ -0,0 +1,147 @@
+#include "PassabilityMap.hpp"
+#include "Arithmetic.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace AStar {
+    PassabilityMap::PassabilityMap() noexcept = default;
+
+    PassabilityMap::PassabilityMap(const Vector2 dimensions) noexcept
+    : _width(dimensions.X), _height(dimensions.Y), _stride((dimensions.X + 2 + 63) / 64) {
+        // Everything starts out blocked, then the interior is opened up
+        _bits.assign(_stride * (_height + 2), 0);
+
+        for (short y = 0; y < _height; ++y) {
+            for (short x = 0; x < _width; ++x) {
+                SetPassable({ x, y });
+            }
+        }
+    }
+
+    auto PassabilityMap::Width() const noexcept -> short {
+        return _width;
+    }
+
+    auto PassabilityMap::Height() const noexcept -> short {
+        return _height;
+    }
+
+    auto PassabilityMap::IsPassable(const Vector2 tile) const noexcept -> bool {
+        const std::size_t bit = BitOf(tile);
+        return (_bits[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    auto PassabilityMap::CanMove(const Vector2 from, const Vector2 direction, const CornerCutting cutting) const noexcept -> bool {
+        const Vector2 to = { static_cast<short>(from.X + direction.X), static_cast<short>(from.Y + direction.Y) };
+
+        if (!IsPassable(to)) {
+            return false;
+        }
+
+        if (direction.X == 0 || direction.Y == 0) {
+            return true;
+        }
+
+        switch (cutting) {
+        case CornerCutting::Never:
+            return IsPassable({ to.X, from.Y }) && IsPassable({ from.X, to.Y });
+
+        case CornerCutting::OneSide:
+            return IsPassable({ to.X, from.Y }) || IsPassable({ from.X, to.Y });
+
+        default:
+            return true;
+        }
+    }
+
+    auto PassabilityMap::IsSpanPassable(const short y, const short fromX, const short toX) const noexcept -> bool {
+        const std::size_t first = BitOf({ fromX, y });
+        const std::size_t last = BitOf({ toX, y });
+
+        for (std::size_t word = first / 64; word <= last / 64; ++word) {
+            std::uint64_t mask = ~std::uint64_t{ 0 };
+
+            if (word == first / 64) {
+                mask &= ~std::uint64_t{ 0 } << (first % 64);
+            }
+
+            if (word == last / 64) {
+                mask &= ~std::uint64_t{ 0 } >> (63 - last % 64);
+            }
+
+            if ((_bits[word] & mask) != mask) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto PassabilityMap::HasLineOfSight(Vector2 from, Vector2 to) const noexcept -> bool {
+        if (from.Y > to.Y) {
+            std::swap(from, to);
+        }
+
+        if (from.Y == to.Y) {
+            return IsSpanPassable(from.Y, std::min(from.X, to.X), std::max(from.X, to.X));
+        }
+
+        // The line crosses each row in one run of tiles, found from where it enters and leaves the row.
+        // Coordinates are doubled so tile edges are whole, and x is kept multiplied by the height
+        // of the line so it stays exact.
+
+        const long long dx = to.X - from.X;
+        const long long dy = to.Y - from.Y;
+
+        for (int row = from.Y; row <= to.Y; ++row) {
+            const long long enter = row == from.Y ? 2 * from.Y : 2 * row - 1;
+            const long long leave = row == to.Y ? 2 * to.Y : 2 * row + 1;
+
+            const long long enterX = 2 * from.X * dy + dx * (enter - 2 * from.Y);
+            const long long leaveX = 2 * from.X * dy + dx * (leave - 2 * from.Y);
+
+            // Tiles whose doubled extent from 2x - 1 to 2x + 1 overlaps the run, touching included
+            const long long first = -FloorDivide(-(std::min(enterX, leaveX) - dy), 2 * dy);
+            const long long last = FloorDivide(std::max(enterX, leaveX) + dy, 2 * dy);
+
+            if (!IsSpanPassable(static_cast<short>(row), static_cast<short>(first), static_cast<short>(last))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto PassabilityMap::Fingerprint() const noexcept -> std::uint64_t {
+        // FNV-1a style mix over the dimensions and the packed words
+        std::uint64_t hash = 14695981039346656037ull;
+
+        const auto mix = [&hash](const std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+
+        mix(static_cast<std::uint64_t>(_width));
+        mix(static_cast<std::uint64_t>(_height));
+
+        for (const std::uint64_t word : _bits) {
+            mix(word);
+        }
+
+        return hash;
+    }
+
+    auto PassabilityMap::SetBlocked(const Vector2 tile) noexcept -> void {
+        const std::size_t bit = BitOf(tile);
+        _bits[bit / 64] &= ~(std::uint64_t{ 1 } << (bit % 64));
+    }
+
+    auto PassabilityMap::SetPassable(const Vector2 tile) noexcept -> void {
+        const std::size_t bit = BitOf(tile);
+        _bits[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+    }
+
+    auto PassabilityMap::BitOf(const Vector2 tile) const noexcept -> std::size_t {
+        return (tile.Y + 1) * _stride * 64 + (tile.X + 1);
+    }
+} // namespace AStar
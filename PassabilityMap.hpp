@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // One bit per tile marking whether it can be entered.
+    // Rows are padded with a blocked border, so neighbours one step outside the map
+    // can be queried without bounds checks and simply read as blocked.
+    class PassabilityMap final {
+    public:
+        PassabilityMap() noexcept;
+        explicit PassabilityMap(Vector2 dimensions) noexcept;
+
+        [[nodiscard]] auto Width() const noexcept -> short;
+        [[nodiscard]] auto Height() const noexcept -> short;
+
+        // Checks if the tile can be entered, valid for coordinates from -1 up to the dimensions
+        [[nodiscard]] auto IsPassable(Vector2 tile) const noexcept -> bool;
+
+        // Checks if a single step in the direction can be taken from the tile.
+        // Diagonal steps also need the tiles they pass between to be passable as the corner cutting rule says.
+        [[nodiscard]] auto CanMove(Vector2 from, Vector2 direction, CornerCutting cutting = CornerCutting::Never) const noexcept -> bool;
+
+        // Checks if every tile of the row between the two columns, both included, is passable.
+        // Whole words of the packed row are tested at once.
+        [[nodiscard]] auto IsSpanPassable(short y, short fromX, short toX) const noexcept -> bool;
+
+        // Checks if the straight line between the centres of two tiles only crosses passable tiles.
+        // Tiles the line merely touches at an edge or corner count too, so it never squeezes between
+        // two blocked tiles or clips a blocked corner, like a diagonal step that does not cut corners.
+        [[nodiscard]] auto HasLineOfSight(Vector2 from, Vector2 to) const noexcept -> bool;
+
+        // Hashes the dimensions and contents, used to tell if precomputed data still matches the map
+        [[nodiscard]] auto Fingerprint() const noexcept -> std::uint64_t;
+
+        // Marks the tile as blocked
+        auto SetBlocked(Vector2 tile) noexcept -> void;
+
+        // Marks the tile as passable
+        auto SetPassable(Vector2 tile) noexcept -> void;
+
+    private:
+        // Gets the bit position of the tile in the padded layout
+        [[nodiscard]] auto BitOf(Vector2 tile) const noexcept -> std::size_t;
+
+        short _width = 0, _height = 0;
+        std::size_t _stride = 0;
+        std::vector<std::uint64_t> _bits;
+    };
+} // namespace AStar
@@ -0,0 +1,21 @@
+#include "PathSmoother.hpp"
+
+namespace AStar {
+    auto PathSmoother::Smooth(const PassabilityMap& map, std::vector<Vector2>& path) noexcept -> void {
+        if (path.size() < 3) {
+            return;
+        }
+
+        // A tile is only kept when the last kept tile cannot see the one after it
+        std::size_t kept = 1;
+
+        for (std::size_t i = 1; i + 1 < path.size(); ++i) {
+            if (!map.HasLineOfSight(path[kept - 1], path[i + 1])) {
+                path[kept++] = path[i];
+            }
+        }
+
+        path[kept++] = path.back();
+        path.resize(kept);
+    }
+} // namespace AStar
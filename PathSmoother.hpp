@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+#include "PassabilityMap.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // String pulling over finished paths. Every tile the path could skip with a straight line
+    // from the last tile kept is dropped, so the path only holds the corners it bends around.
+    class PathSmoother final {
+    public:
+        // Pulls the path taut in place, keeping its first and last tile.
+        // Lines are checked against passability alone, so on grids with terrain costs
+        // a shortcut may cross tiles dearer than those it replaces.
+        static auto Smooth(const PassabilityMap& map, std::vector<Vector2>& path) noexcept -> void;
+    };
+} // namespace AStar
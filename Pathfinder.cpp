@@ -1,163 +1,769 @@
 #include "Pathfinder.hpp"
+#include "JumpPointSearch.hpp"
+#include "PathSmoother.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
-
-auto operator==(const Vector2& lhs, const Vector2& rhs) -> bool {
-    return lhs.X == rhs.X && lhs.Y == rhs.Y;
-}
+#include <limits>
+#include <span>
+#include <thread>
+#include <type_traits>
 
 namespace AStar {
-    Pathfinder::Pathfinder() : _area({ 0, 0 }), _start({ 0, 0 }), _end({ 0, 0 }) {
+    namespace {
+        auto Sign(const int value) noexcept -> int {
+            return (value > 0) - (value < 0);
+        }
+    }
+
+    Pathfinder::Pathfinder() : _start({ 0, 0 }), _end({ 0, 0 }), _grid(std::make_shared<const Grid>()) {
 
     }
 
-    auto Pathfinder::GetArea() noexcept -> Area& {
-        return _area;
+    Pathfinder::Pathfinder(const Vector2 dimensions, const Vector2 *obstacles, const std::size_t obstacleCount, const SearchOptions& options) noexcept
+    : Pathfinder(std::make_shared<const Grid>(dimensions, std::span(obstacles, obstacleCount)), options) {
+
+    }
+
+    Pathfinder::Pathfinder(std::shared_ptr<const Grid> grid, const SearchOptions& options) noexcept
+    : _options(options), _start(), _end(), _grid(std::move(grid)) {
+
     }
 
-    Pathfinder::Pathfinder(const Vector2 dimensions, const Vector2 *obstacles, const short obstacleCount) noexcept
-    : _area(dimensions, L' '), _start(), _end(), _obstacles(obstacles, obstacles + obstacleCount) {
-        // Fill the area obstacles
-        constexpr Tile obstacle = { L'x', Console::Color::ForegroundBrightRed };
+    auto Pathfinder::SetGrid(std::shared_ptr<const Grid> grid) noexcept -> void {
+        _grid = std::move(grid);
 
-        for (short i = 0; i < obstacleCount; ++i) {
-            _area.Set(obstacles[i], obstacle);
+        if (_jumpTable && !_jumpTable->Matches(_grid->GetPassability())) {
+            _jumpTable.reset();
         }
+
+        if (_landmarks && !_landmarks->Matches(_grid->GetPassability())) {
+            _landmarks.reset();
+        }
+    }
+
+    auto Pathfinder::SetOptions(const SearchOptions& options) noexcept -> void {
+        _options = options;
+    }
+
+    auto Pathfinder::SetJumpTable(std::shared_ptr<const JumpTable> table) noexcept -> void {
+        // A table made for another layout would send jumps through walls
+        _jumpTable = table && table->Matches(_grid->GetPassability()) ? std::move(table) : nullptr;
+    }
+
+    auto Pathfinder::SetLandmarks(std::shared_ptr<const LandmarkTable> table) noexcept -> void {
+        // Costs from another layout could overestimate and lose the shortest path
+        _landmarks = table && table->Matches(_grid->GetPassability()) ? std::move(table) : nullptr;
     }
 
     auto Pathfinder::Update() noexcept -> Status {
-        if (_openSet.empty()) {
+        return Update(Budget{ .maxExpansions = 1 }).status;
+    }
+
+    auto Pathfinder::Update(const Budget& budget) noexcept -> Progress {
+        const std::size_t expansions = Run(budget);
+
+        if (expansions > 0 && _status == Status::Success) {
+            const StatisticsTimer timer(_statistics.reconstructTime);
+            ReconstructPath(_path);
+        }
+
+        if (expansions > 0 && _status != Status::InProgress) {
+            RecordStatistics();
+        }
+
+        return {
+            _status,
+            expansions,
+            _expansions,
+            std::visit([](const auto& openSet) { return openSet.Size(); }, _forward.openSet)
+                + (_bidirectional ? std::visit([](const auto& openSet) { return openSet.Size(); }, _backward.openSet) : 0)
+        };
+    }
+
+    auto Pathfinder::FindPath(const Vector2 start, const Vector2 end) noexcept -> Result {
+        Initialize(start, end);
+
+        if (_bidirectional && _search.direction == Direction::ParallelBidirectional) {
+            RunConcurrently();
+        }
+        else {
+            Run(Budget{});
+        }
+
+        Result result = { _status, {}, GetCost(), {} };
+
+        if (_status == Status::Success) {
+            const StatisticsTimer timer(_statistics.reconstructTime);
+            ReconstructPath(result.path);
+        }
+
+        RecordStatistics();
+        result.statistics = GetStatistics();
+
+        return result;
+    }
+
+    auto Pathfinder::RebuildPath() noexcept -> bool {
+        if (_status != Status::Success) {
+            return false;
+        }
+
+        ReconstructPath(_path);
+        return true;
+    }
+
+    auto Pathfinder::Run(const Budget& budget) noexcept -> std::size_t {
+        if (_status != Status::InProgress) {
+            return 0;
+        }
+
+        const TraceScope trace("Pathfinder::Search");
+        const StatisticsTimer timer(_statistics.searchTime);
+
+        // Only read the clock when there is a time limit, and then only every few expansions
+
+        const bool timed = budget.maxTime != std::chrono::nanoseconds::max();
+        const auto started = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+        std::size_t expansions = 0;
+
+        const auto expandWithinBudget = [&](auto&& expand) {
+            Status status = Status::InProgress;
+
+            while (status == Status::InProgress && expansions < budget.maxExpansions) {
+                status = expand();
+                ++expansions;
+
+                if (timed && expansions % TimeCheckInterval == 0
+                    && std::chrono::steady_clock::now() - started >= budget.maxTime) {
+                    break;
+                }
+            }
+
+            return status;
+        };
+
+        // Resolve the policy and open lists once and expand in a tight loop
+
+        if (_bidirectional) {
+            _status = std::visit([&]<typename Policy>(const Policy&, auto& forward, auto& backward) {
+                return expandWithinBudget([&] { return ExpandBidirectional<Policy>(forward, backward); });
+            }, _policy, _forward.openSet, _backward.openSet);
+        }
+        else {
+            _status = std::visit([&]<typename Policy>(const Policy&, auto& openSet) {
+                return expandWithinBudget([&] { return Expand<Policy>(openSet); });
+            }, _policy, _forward.openSet);
+        }
+
+        _expansions += expansions;
+
+        return expansions;
+    }
+
+    auto Pathfinder::RunConcurrently() noexcept -> void {
+        if (_status != Status::InProgress) {
+            return;
+        }
+
+        const TraceScope trace("Pathfinder::Search");
+        const StatisticsTimer timer(_statistics.searchTime);
+
+        _concurrent = true;
+        std::size_t backwardExpansions = 0;
+
+        const std::size_t forwardExpansions = std::visit([&]<typename Policy>(const Policy&, auto& forward, auto& backward) {
+            // Joined when it goes out of scope, before the results are read
+            std::jthread backwardSearch([&] {
+                const TraceScope backwardTrace("Pathfinder::SearchBackward");
+                backwardExpansions = RunFrontier<Policy>(_backward, backward, _forward);
+            });
+            return RunFrontier<Policy>(_forward, forward, _backward);
+        }, _policy, _forward.openSet, _backward.openSet);
+
+        _concurrent = false;
+        _expansions += forwardExpansions + backwardExpansions;
+        _status = std::min(_forward.bestCost, _backward.bestCost) < std::numeric_limits<double>::infinity() ? Status::Success : Status::Error;
+    }
+
+    template<typename Policy, typename OpenSet>
+    auto Pathfinder::Expand(OpenSet& openSet) noexcept -> Status {
+        if (openSet.Empty()) {
             return Status::Error;
         }
 
         // Pop the lowest cost tile
 
-        Vector2 current = _openSet.top().first;
-        _openSet.pop();
-        _openSetResidency.at(current) = false;
+        const int currentIndex = openSet.Pop();
+        const Vector2 current = PositionOf(currentIndex);
+        Node& currentNode = NodeAt(_forward, currentIndex);
 
         if (current == _end) {
-            ReconstructPath(current);
             return Status::Success;
         }
 
         // Mark the tile as visited
 
-        _closedSet.emplace(current);
-        _area.Set(current, {L'0', Console::Color::ForegroundBrightMagenta });
+        currentNode.closed = true;
+
+        if constexpr (StatisticsEnabled) {
+            ++_forward.statistics.expanded;
+        }
 
-        // Check neighbouring tiles
+        // Queue the successors of the tile
 
-        for (const auto&[dirX, dirY] : _directions) {
-            Vector2 neighbour = { static_cast<short>(current.X + dirX), static_cast<short>(current.Y + dirY) };
+        const PassabilityMap& passability = _grid->GetPassability();
 
-            if (!IsValid(neighbour)) {
-                continue;
+        if (_search.expansion == Expansion::JumpPoint) {
+            // Jump along each direction that survives pruning and only queue the tiles where the jumps stop
+            std::array<Vector2, 8> directions;
+            const int count = JumpPointSearch::Directions(passability, current, ArrivalDirection(currentIndex), directions);
+
+            for (int i = 0; i < count; ++i) {
+                Vector2 jumpPoint;
+
+                if (JumpPointSearch::Jump(passability, current, directions[i], _end, jumpPoint)) {
+                    Relax<Policy>(_forward, openSet, currentIndex, jumpPoint, OctileDistance::Estimate<typename Policy::Cost::Units>(current, jumpPoint));
+                }
             }
+        }
+        else if (_search.expansion == Expansion::JumpPointPlus) {
+            // Same pruning, but the jumps are looked up instead of scanned.
+            // The table knows nothing about the end point, so jumps passing it are cut short here.
+            std::array<Vector2, 8> directions;
+            const int count = JumpPointSearch::Directions(passability, current, ArrivalDirection(currentIndex), directions);
+
+            const int toEndX = _end.X - current.X;
+            const int toEndY = _end.Y - current.Y;
+
+            for (int i = 0; i < count; ++i) {
+                const auto [dirX, dirY] = directions[i];
+                const int distance = _jumpTable->Distance(current, directions[i]);
+                const int reach = std::abs(distance);
+
+                // Steps along the direction until the end point, or its row or column for diagonals
+                int stepsToEnd = 0;
+
+                if (dirX != 0 && dirY != 0) {
+                    if (Sign(toEndX) == dirX && Sign(toEndY) == dirY) {
+                        stepsToEnd = std::min(std::abs(toEndX), std::abs(toEndY));
+                    }
+                }
+                else if (dirX != 0 ? toEndY == 0 && Sign(toEndX) == dirX : toEndX == 0 && Sign(toEndY) == dirY) {
+                    stepsToEnd = std::abs(toEndX + toEndY);
+                }
+
+                const int steps = stepsToEnd > 0 && stepsToEnd <= reach ? stepsToEnd : distance;
 
-            // Calculate scores and update lists
+                if (steps > 0) {
+                    const Vector2 target = { static_cast<short>(current.X + dirX * steps), static_cast<short>(current.Y + dirY * steps) };
+                    Relax<Policy>(_forward, openSet, currentIndex, target, OctileDistance::Estimate<typename Policy::Cost::Units>(current, target));
+                }
+            }
+        }
+        else {
+            // Theta* links a neighbour straight to the parent of the tile when nothing blocks the line between them
+            const bool thetaStar = _search.expansion == Expansion::ThetaStar;
+            const int parentIndex = thetaStar ? currentNode.cameFrom : -1;
+            const Vector2 parent = parentIndex != -1 ? PositionOf(parentIndex) : current;
+
+            // A fixed-size array, so the loop unrolls for each neighbourhood
+            for (const Vector2& direction : Policy::Connectivity::Directions) {
+                if (!passability.CanMove(current, direction, _search.cornerCutting)) {
+                    continue;
+                }
 
-            double tentative = _gScore.at(current) + 1;
+                const Vector2 neighbour = { static_cast<short>(current.X + direction.X), static_cast<short>(current.Y + direction.Y) };
 
-            if (tentative < _gScore.at(neighbour)) {
-                _gScore.at(neighbour) = tentative;
-                _fScore.at(neighbour) = tentative + DistanceToEnd(neighbour);
-                _cameFrom.at(neighbour) = current;
+                if (thetaStar) {
+                    // Closed tiles keep their links, so no path is shortened under tiles already linked to it
+                    // and every cost stays exactly the length of the links it adds up
+                    if (NodeAt(_forward, Index(neighbour)).closed) {
+                        continue;
+                    }
 
-                if (!_openSetResidency.at(neighbour)) {
-                    _openSet.emplace(std::make_pair(neighbour, _fScore.at(neighbour)));
-                    _area.Set(neighbour, {L'o', Console::Color::ForegroundBrightCyan });
-                    _openSetResidency.at(neighbour) = true;
+                    if (parentIndex != -1 && passability.HasLineOfSight(parent, neighbour)) {
+                        Relax<Policy>(_forward, openSet, parentIndex, neighbour, EuclideanDistance::Estimate<typename Policy::Cost::Units>(parent, neighbour));
+                        continue;
+                    }
                 }
+
+                Relax<Policy>(_forward, openSet, currentIndex, neighbour, Policy::Cost::StepCost(*_grid, neighbour, direction));
             }
         }
 
-        // Render the updated area
+        return Status::InProgress;
+    }
 
-        _area.Render();
+    template<typename Policy, typename ForwardSet, typename BackwardSet>
+    auto Pathfinder::ExpandBidirectional(ForwardSet& forward, BackwardSet& backward) noexcept -> Status {
+        if (Settled(_forward, forward, _backward) || Settled(_backward, backward, _forward)) {
+            return std::min(_forward.bestCost, _backward.bestCost) < std::numeric_limits<double>::infinity()
+                ? Status::Success
+                : Status::Error;
+        }
+
+        // Growing the smaller frontier keeps the two balanced when one end is boxed in
+        if (forward.Size() <= backward.Size()) {
+            ExpandFrontier<Policy>(_forward, forward);
+        }
+        else {
+            ExpandFrontier<Policy>(_backward, backward);
+        }
 
         return Status::InProgress;
     }
 
-    auto Pathfinder::Initialize(const Vector2 start, const Vector2 end) noexcept -> void {
-        // Clear everything and re-initialize the area
-        _area.Clear();
+    template<typename Policy, typename OpenSet>
+    auto Pathfinder::ExpandFrontier(Frontier& frontier, OpenSet& openSet) noexcept -> void {
+        const int currentIndex = openSet.Pop();
+        const Vector2 current = PositionOf(currentIndex);
+
+        frontier.nodes[currentIndex].closed = true;
+
+        if constexpr (StatisticsEnabled) {
+            ++frontier.statistics.expanded;
+        }
+
+        // The backward frontier steps through the same neighbours, but walks each step against its direction,
+        // so the step enters the current tile and pays its terrain cost
+
+        const PassabilityMap& passability = _grid->GetPassability();
+        const bool backward = &frontier == &_backward;
+
+        for (const Vector2& direction : Policy::Connectivity::Directions) {
+            if (!passability.CanMove(current, direction, _search.cornerCutting)) {
+                continue;
+            }
+
+            const Vector2 neighbour = { static_cast<short>(current.X + direction.X), static_cast<short>(current.Y + direction.Y) };
+            const double cost = Policy::Cost::StepCost(*_grid, backward ? current : neighbour, direction);
+            Relax<Policy>(frontier, openSet, currentIndex, neighbour, cost);
+        }
+    }
+
+    template<typename Policy, typename OpenSet>
+    auto Pathfinder::RunFrontier(Frontier& frontier, OpenSet& openSet, Frontier& opposite) noexcept -> std::size_t {
+        std::size_t expansions = 0;
 
-        constexpr Tile obstacle = { L'x', Console::Color::ForegroundBrightRed };
+        // Either frontier settling proves the best path found so far optimal
+        while (!std::atomic_ref(opposite.settled).load(std::memory_order_acquire)) {
+            if (Settled(frontier, openSet, opposite)) {
+                std::atomic_ref(frontier.settled).store(true, std::memory_order_release);
+                break;
+            }
+
+            ExpandFrontier<Policy>(frontier, openSet);
+            ++expansions;
+        }
+
+        return expansions;
+    }
+
+    template<typename OpenSet>
+    auto Pathfinder::Settled(Frontier& frontier, OpenSet& openSet, Frontier& opposite) noexcept -> bool {
+        if (openSet.Empty()) {
+            return true;
+        }
+
+        // With a consistent heuristic every path still to be found costs at least the lowest open score
+        const double bestCost = std::min(frontier.bestCost, std::atomic_ref(opposite.bestCost).load(std::memory_order_acquire));
+        return frontier.nodes[openSet.Top()].fScore >= bestCost;
+    }
+
+    template<typename Policy, typename OpenSet>
+    auto Pathfinder::Relax(Frontier& frontier, OpenSet& openSet, const int fromIndex, const Vector2 to, const double cost) noexcept -> void {
+        const int toIndex = Index(to);
+        Node& toNode = NodeAt(frontier, toIndex);
+
+        // Calculate scores and update lists
+
+        const double tentative = frontier.nodes[fromIndex].gScore + cost;
+
+        if (tentative >= toNode.gScore) {
+            if constexpr (StatisticsEnabled) {
+                ++frontier.statistics.discarded;
+            }
 
-        for (short i = 0; i < _obstacles.size(); ++i) {
-            _area.Set(_obstacles[i], obstacle);
+            return;
         }
 
-        _area.Set(start, { L'S', Console::Color::ForegroundBrightGreen });
-        _area.Set(end, { L'E', Console::Color::ForegroundBrightYellow } );
+        // Scores are stored atomically since the opposite frontier may read them from another thread
+        std::atomic_ref(toNode.gScore).store(tentative, std::memory_order_relaxed);
+        toNode.fScore = tentative + EstimateDistance<Policy>(to, frontier.target);
+        toNode.cameFrom = fromIndex;
 
+        // A tile the opposite frontier has reached joins the two into a path
+        if (_bidirectional) {
+            Frontier& opposite = &frontier == &_forward ? _backward : _forward;
+            Node& meeting = opposite.nodes[toIndex];
+
+            // Orders the score written above against the opposite thread's own writes,
+            // so whenever both frontiers reach a tile at once at least one sees the other
+            if (_concurrent) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            if (std::atomic_ref(meeting.generation).load(std::memory_order_acquire) == _generation) {
+                const double through = tentative + std::atomic_ref(meeting.gScore).load(std::memory_order_relaxed);
+
+                if (through < frontier.bestCost) {
+                    std::atomic_ref(frontier.bestCost).store(through, std::memory_order_release);
+                    frontier.meeting = toIndex;
+                }
+            }
+        }
+
+        // Re-prioritise the tile in place if it is already open, otherwise (re)open it
+
+        const auto priority = static_cast<typename OpenSet::Priority>(toNode.fScore);
+
+        if (openSet.Contains(toIndex)) {
+            openSet.DecreaseKey(toIndex, priority);
+
+            if constexpr (StatisticsEnabled) {
+                ++frontier.statistics.updated;
+            }
+        }
+        else {
+            if constexpr (StatisticsEnabled) {
+                frontier.statistics.reopened += toNode.closed;
+                ++frontier.statistics.pushed;
+            }
+
+            toNode.closed = false;
+            openSet.Push(toIndex, priority);
+
+            if constexpr (StatisticsEnabled) {
+                frontier.statistics.peakOpen = std::max(frontier.statistics.peakOpen, openSet.Size());
+            }
+        }
+    }
+
+    auto Pathfinder::Initialize(const Vector2 start, const Vector2 end) noexcept -> void {
         _start = start;
         _end = end;
+        _status = Status::InProgress;
+        _expansions = 0;
+        _statistics = {};
+        _path.clear();
+
+        // Tiles off the grid have no nodes and no path leaves or enters a blocked tile,
+        // so such searches fail before any node is touched, whichever ends they grow from
+        const PassabilityMap& passability = _grid->GetPassability();
+
+        const auto onGrid = [this](const Vector2 tile) {
+            return tile.X >= 0 && tile.Y >= 0 && tile.X < _grid->Width() && tile.Y < _grid->Height();
+        };
+
+        if (!onGrid(start) || !onGrid(end) || !passability.IsPassable(start) || !passability.IsPassable(end)) {
+            _forward.statistics = {};
+            _backward.statistics = {};
+            _status = Status::Error;
+            return;
+        }
+
+        // Jump point searches assume every tile costs the same and no corners are cut, Theta* only the former,
+        // otherwise they search every 8-connected neighbour instead
+        _search = _options;
+
+        const bool jumpPoint = _search.expansion == Expansion::JumpPoint || _search.expansion == Expansion::JumpPointPlus;
+
+        if ((_grid->HasTerrainCosts() && _search.expansion != Expansion::Standard)
+            || (_search.cornerCutting != CornerCutting::Never && jumpPoint)) {
+            _search.expansion = Expansion::Standard;
+            _search.neighbourhood = Neighbourhood::Eight;
+        }
+
+        // Lines of sight never clip corners, so Theta*'s grid steps do not either
+        if (_search.expansion == Expansion::ThetaStar) {
+            _search.cornerCutting = CornerCutting::Never;
+        }
 
-        _closedSet.clear();
+        _bidirectional = _search.direction != Direction::Forward && _search.expansion == Expansion::Standard;
+        _policy = SelectPolicy(_search, *_grid);
 
-        // Fill maps with initial data. 
-        // Taking advantage of the indexing operator that either creates or accesses the value at the key.
+        // Buckets truncate scores, so they only order searches whose steps are all whole.
+        // Diagonals in tile units and Theta*'s straight lines are not, those go to the heap.
+        const bool wholeSteps = std::visit([]<typename Policy>(const Policy&) {
+            return Policy::Cost::Units::Integer || std::is_same_v<typename Policy::Connectivity, FourConnected>;
+        }, _policy);
 
-        for (short x = 0; x < _area.Width(); ++x) {
-            for (short y = 0; y < _area.Height(); ++y) {
-                _gScore[{ x, y }] = std::numeric_limits<double>::infinity();
-                _fScore[{ x, y }] = std::numeric_limits<double>::infinity();
-                _cameFrom[{ x, y }] = Vector2{ -10, -10 };
-                _openSetResidency[{ x, y }] = false;
+        if (!wholeSteps) {
+            _search.openList = OpenList::BinaryHeap;
+        }
+
+        _heuristicScale = _grid->MinimumCost();
+        _costUnit = std::visit([]<typename Policy>(const Policy&) { return Policy::Cost::Units::Straight; }, _policy);
+
+        // Diagonal moves only make routes cheaper, so costs measured with them bound any search
+        // that does not cut corners or take any-angle shortcuts, which make routes cheaper still
+        const bool fourConnected = _search.neighbourhood == Neighbourhood::Four && _search.expansion == Expansion::Standard;
+
+        _useLandmarks = _landmarks && _landmarks->LandmarkCount() > 0 && _search.expansion != Expansion::ThetaStar
+            && (fourConnected || _search.cornerCutting == CornerCutting::Never)
+            && (fourConnected || _landmarks->GetNeighbourhood() == Neighbourhood::Eight);
+
+        if (_search.expansion == Expansion::JumpPointPlus && !_jumpTable) {
+            _jumpTable = std::make_shared<const JumpTable>(_grid->GetPassability());
+        }
+
+        // Start a new generation so every node from the previous search reads as unvisited.
+        // The stores are only walked when they are first allocated or the counter wraps around.
+
+        const std::size_t nodeCount = static_cast<std::size_t>(_grid->Width()) * _grid->Height();
+
+        if (_forward.nodes.size() != nodeCount || ++_generation == 0) {
+            _forward.nodes.clear();
+            _backward.nodes.clear();
+            _generation = 1;
+        }
+
+        Reset(_forward, start, end);
+
+        if (_bidirectional) {
+            Reset(_backward, end, start);
+
+            // The frontiers already meet when the search starts on the end tile
+            if (start == end) {
+                _forward.bestCost = 0;
+                _forward.meeting = Index(start);
             }
         }
+    }
+
+    auto Pathfinder::GetGrid() const noexcept -> const Grid& {
+        return *_grid;
+    }
+
+    auto Pathfinder::GetStart() const noexcept -> Vector2 {
+        return _start;
+    }
+
+    auto Pathfinder::GetEnd() const noexcept -> Vector2 {
+        return _end;
+    }
+
+    auto Pathfinder::GetTileState(const Vector2 tile) const noexcept -> TileState {
+        const int index = Index(tile);
+        const TileState forward = TileStateIn(_forward, index);
+
+        if (!_bidirectional) {
+            return forward;
+        }
+
+        return std::max(forward, TileStateIn(_backward, index));
+    }
+
+    auto Pathfinder::GetPath() const noexcept -> const std::vector<Vector2>& {
+        return _path;
+    }
+
+    auto Pathfinder::GetCost() const noexcept -> double {
+        if (_status != Status::Success) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        if (_bidirectional) {
+            return std::min(_forward.bestCost, _backward.bestCost) / _costUnit;
+        }
+
+        return _forward.nodes[Index(_end)].gScore / _costUnit;
+    }
+
+    auto Pathfinder::GetExpansions() const noexcept -> std::size_t {
+        return _expansions;
+    }
+
+    auto Pathfinder::GetStatistics() const noexcept -> SearchStatistics {
+        SearchStatistics statistics = _statistics;
+        statistics += _forward.statistics;
+
+        // The frontiers peak separately, so their sum bounds the peak of both together
+        if (_bidirectional) {
+            statistics += _backward.statistics;
+            statistics.peakOpen = _forward.statistics.peakOpen + _backward.statistics.peakOpen;
+        }
 
-        while (!_openSet.empty()) {
-            _openSet.pop();
+        return statistics;
+    }
+
+    auto Pathfinder::ArrivalDirection(const int index) noexcept -> Vector2 {
+        const int parentIndex = NodeAt(_forward, index).cameFrom;
+
+        if (parentIndex == -1) {
+            return { 0, 0 };
         }
 
-        _gScore.at(start) = 0;
-        _fScore.at(start) = DistanceToEnd(start);
+        const Vector2 tile = PositionOf(index);
+        const Vector2 parent = PositionOf(parentIndex);
+
+        return { static_cast<short>(Sign(tile.X - parent.X)), static_cast<short>(Sign(tile.Y - parent.Y)) };
+    }
+
+    auto Pathfinder::NodeAt(Frontier& frontier, const int index) noexcept -> Node& {
+        Node& node = frontier.nodes[index];
+
+        if (node.generation != _generation) {
+            // The score is reset before the node is stamped, so the opposite frontier never pairs
+            // the new generation with a score left over from an older search
+            std::atomic_ref(node.gScore).store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+            node.fScore = std::numeric_limits<double>::infinity();
+            node.cameFrom = -1;
+            node.closed = false;
+            std::atomic_ref(node.generation).store(_generation, std::memory_order_release);
+        }
 
-        _openSet.emplace(std::make_pair(start, _fScore.at(start)));
-        _openSetResidency.emplace(std::make_pair(start, true));
+        return node;
     }
 
-    auto Pathfinder::DrawPath() noexcept -> void {
-        _area.DrawPath(_path);
+    auto Pathfinder::Reset(Frontier& frontier, const Vector2 origin, const Vector2 target) noexcept -> void {
+        const std::size_t nodeCount = static_cast<std::size_t>(_grid->Width()) * _grid->Height();
+        const bool resized = frontier.nodes.size() != nodeCount;
+
+        if (resized) {
+            frontier.nodes.assign(nodeCount, Node{});
+        }
+
+        // Switch the open list implementation if the options asked for a different one
+
+        if (resized || frontier.openSet.index() != static_cast<std::size_t>(_search.openList)) {
+            switch (_search.openList) {
+            case OpenList::BinaryHeap:
+                frontier.openSet.emplace<IndexedHeap<double>>();
+                break;
+
+            case OpenList::Buckets:
+                frontier.openSet.emplace<BucketQueue>();
+                break;
+            }
+
+            std::visit([nodeCount](auto& openSet) { openSet.Reserve(static_cast<int>(nodeCount)); }, frontier.openSet);
+        }
+
+        frontier.target = target;
+        frontier.bestCost = std::numeric_limits<double>::infinity();
+        frontier.meeting = -1;
+        frontier.settled = false;
+        frontier.statistics = {};
+
+        if constexpr (StatisticsEnabled) {
+            frontier.statistics.pushed = 1;
+            frontier.statistics.peakOpen = 1;
+        }
+
+        Node& originNode = NodeAt(frontier, Index(origin));
+        originNode.gScore = 0;
+        originNode.fScore = EstimateDistance(origin, target);
+
+        std::visit([&]<typename OpenSet>(OpenSet& openSet) {
+            openSet.Clear();
+            openSet.Push(Index(origin), static_cast<typename OpenSet::Priority>(originNode.fScore));
+        }, frontier.openSet);
     }
 
-    auto Pathfinder::ReconstructPath(const Vector2& end) noexcept -> void{
-        while (!_path.empty()) {
-            _path.pop();
+    auto Pathfinder::TileStateIn(const Frontier& frontier, const int index) const noexcept -> TileState {
+        // Nodes from older searches read as unvisited without being reset
+        if (frontier.nodes.empty() || frontier.nodes[index].generation != _generation) {
+            return TileState::Unvisited;
+        }
+
+        if (std::visit([index](const auto& openSet) { return openSet.Contains(index); }, frontier.openSet)) {
+            return TileState::Open;
         }
 
-        _path.emplace(end);
+        return frontier.nodes[index].closed ? TileState::Closed : TileState::Unvisited;
+    }
+
+    auto Pathfinder::Index(const Vector2 tile) const noexcept -> int {
+        return tile.Y * _grid->Width() + tile.X;
+    }
+
+    auto Pathfinder::PositionOf(const int index) const noexcept -> Vector2 {
+        return { static_cast<short>(index % _grid->Width()), static_cast<short>(index / _grid->Width()) };
+    }
+
+    auto Pathfinder::ReconstructPath(std::vector<Vector2>& path) const noexcept -> void {
+        const TraceScope trace("Pathfinder::ReconstructPath");
+
+        path.clear();
 
-        Vector2 current = end;
+        // A bidirectional path runs back from the meeting tile to the start, then on to the end
+
+        if (_bidirectional) {
+            const int meeting = _forward.bestCost <= _backward.bestCost ? _forward.meeting : _backward.meeting;
+
+            path.push_back(PositionOf(meeting));
+            AppendLinks(_forward, meeting, path);
+            std::ranges::reverse(path);
+            AppendLinks(_backward, meeting, path);
+        }
+        else {
+            // The links run backwards from the end tile
+            path.push_back(_end);
+            AppendLinks(_forward, Index(_end), path);
+            std::ranges::reverse(path);
+        }
 
-        // Traverse the links until the start node is found
+        if (_search.smoothPaths) {
+            PathSmoother::Smooth(_grid->GetPassability(), path);
+        }
+    }
 
-        while (_cameFrom.contains(current)) {
-            current = _cameFrom.at(current);
-            _path.emplace(current);
+    auto Pathfinder::RecordStatistics() noexcept -> void {
+        if constexpr (StatisticsEnabled) {
+            _statistics.searches = 1;
+            RecordThreadStatistics(GetStatistics());
         }
     }
 
-    auto Pathfinder::IsValid(const Vector2 &tile) noexcept -> bool {
-        return tile.X > -1 && tile.Y > -1
-            && tile.X < _area.Width() && tile.Y < _area.Height()
-            && !std::ranges::contains(_obstacles, tile);
+    auto Pathfinder::AppendLinks(const Frontier& frontier, const int index, std::vector<Vector2>& path) const noexcept -> void {
+        // Traverse the links until the origin node is found.
+        // Jump point links span straight or diagonal lines, so the skipped tiles are stepped through.
+        // Any-angle links are kept as they are, so the path only holds the tiles where it turns.
+
+        for (int current = index; frontier.nodes[current].cameFrom != -1; current = frontier.nodes[current].cameFrom) {
+            const Vector2 parent = PositionOf(frontier.nodes[current].cameFrom);
+            Vector2 tile = PositionOf(current);
+
+            if (_search.expansion == Expansion::ThetaStar) {
+                path.push_back(parent);
+                continue;
+            }
+
+            while (tile != parent) {
+                tile.X += static_cast<short>((parent.X > tile.X) - (parent.X < tile.X));
+                tile.Y += static_cast<short>((parent.Y > tile.Y) - (parent.Y < tile.Y));
+                path.push_back(tile);
+            }
+        }
     }
 
-    auto Pathfinder::DistanceToEnd(const Vector2 &tile) const noexcept -> double {
-        // Manhattan distance converges faster to the path,
-        // but euclidean distance produces more interesting paths.
+    template<typename Policy>
+    auto Pathfinder::EstimateDistance(const Vector2& tile, const Vector2& target) const noexcept -> double {
+        using Units = typename Policy::Cost::Units;
 
-        // Manhattan distance
+        double estimate = Policy::Distance::template Estimate<Units>(tile, target);
 
-        return std::abs(tile.X - _end.X) + std::abs(tile.Y - _end.Y);
+        // Both bounds are admissible, so the larger one is too.
+        // Landmark costs are in tiles, and no step is cheaper in integer units than its length.
+        if (_useLandmarks) {
+            const double bound = _landmarks->EstimateDistance(tile, target) * Units::Straight;
+            estimate = std::max(estimate, Units::Integer ? std::floor(bound) : bound);
+        }
 
-        // Euclidean distance
+        // Both bounds count steps as if every tile cost one, no tile costs less than the cheapest
+        if constexpr (!Policy::Cost::Uniform) {
+            estimate *= _heuristicScale;
+        }
+
+        return estimate;
+    }
 
-        /*short dx = tile.X - _end.X;
-        short dy = tile.Y - _end.Y;
-        return sqrt(dx * dx + dy * dy);*/
+    auto Pathfinder::EstimateDistance(const Vector2& tile, const Vector2& target) const noexcept -> double {
+        return std::visit([&]<typename Policy>(const Policy&) { return EstimateDistance<Policy>(tile, target); }, _policy);
     }
 } // namespace AStar
@@ -1,32 +1,19 @@
 #pragma once
 
-#include <queue>
-#include <stack>
-#include <unordered_set>
-#include <unordered_map>
-#include "Windows.hpp"
-#include "Area.hpp"
-
-// Hasher for vector2
-template<>
-struct std::hash<Vector2> {
-    std::size_t operator()(const Vector2& x) const noexcept {
-        return x.X * 310248241ull ^ x.Y * 696729599ull;
-    }
-};
-
-// Comparison for fScore heap
-template<>
-struct std::greater<std::pair<Vector2, double>> {
-    constexpr bool operator()(
-        const std::pair<Vector2, double>& lhs,
-        const std::pair<Vector2, double>& rhs) const {
-        return lhs.second > rhs.second;
-    }
-};
-
-// Equals for searching
-auto operator==(const Vector2& lhs, const Vector2& rhs) -> bool;
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <variant>
+#include <vector>
+#include "BucketQueue.hpp"
+#include "Grid.hpp"
+#include "IndexedHeap.hpp"
+#include "JumpTable.hpp"
+#include "LandmarkTable.hpp"
+#include "SearchPolicies.hpp"
+#include "SearchOptions.hpp"
+#include "SearchStatistics.hpp"
+#include "Vector2.hpp"
 
 namespace AStar {
     class Pathfinder final {
@@ -37,46 +24,200 @@ namespace AStar {
             Error
         };
 
+        // How far the current search has got with a tile
+        enum class TileState {
+            Unvisited,
+            Open,
+            Closed
+        };
+
+        // Outcome of a complete search
+        struct Result {
+            Status status;
+            std::vector<Vector2> path; // From the start to the end tile, empty if no path exists
+            double cost;
+            SearchStatistics statistics; // All zero unless statistics are compiled in
+        };
+
+        // Limits on the work a single Update call may do
+        struct Budget {
+            std::size_t maxExpansions = std::numeric_limits<std::size_t>::max();
+            std::chrono::nanoseconds maxTime = std::chrono::nanoseconds::max();
+        };
+
+        // State of a search after an Update call
+        struct Progress {
+            Status status;
+            std::size_t expansions;      // Tiles expanded by this call
+            std::size_t totalExpansions; // Tiles expanded since the search was initialized
+            std::size_t openCount;       // Tiles waiting in the open list
+        };
+
         Pathfinder();
-        [[nodiscard]] auto GetArea() noexcept -> Area&;
-        Pathfinder(Vector2 dimensions, const Vector2* obstacles, short obstacleCount) noexcept;
+        Pathfinder(Vector2 dimensions, const Vector2* obstacles, std::size_t obstacleCount, const SearchOptions& options = {}) noexcept;
+
+        // Creates a search context over a grid shared with other pathfinders
+        explicit Pathfinder(std::shared_ptr<const Grid> grid, const SearchOptions& options = {}) noexcept;
+
+        // Switches to another grid for subsequent searches
+        auto SetGrid(std::shared_ptr<const Grid> grid) noexcept -> void;
+
+        // Sets the options used by the next search
+        auto SetOptions(const SearchOptions& options) noexcept -> void;
+
+        // Shares a precomputed jump table for JPS+ searches.
+        // Without one, a table is built from the grid when a JPS+ search starts.
+        auto SetJumpTable(std::shared_ptr<const JumpTable> table) noexcept -> void;
+
+        // Shares landmark costs that sharpen the heuristic with the ALT lower bound.
+        // Tables measured with diagonal moves serve every search, 4-connected ones only 4-connected standard searches.
+        auto SetLandmarks(std::shared_ptr<const LandmarkTable> table) noexcept -> void;
 
         // Updates the search step
         auto Update() noexcept -> Status;
 
-        // Initializes a new search
+        // Continues the search until it finishes or the budget runs out, whichever comes first.
+        // The time limit is checked every few expansions, so it can be overshot slightly.
+        auto Update(const Budget& budget) noexcept -> Progress;
+
+        // Runs a whole search from the start to the end tile without stopping between steps
+        [[nodiscard]] auto FindPath(Vector2 start, Vector2 end) noexcept -> Result;
+
+        // Builds the path of a solved search again from its parent links, for timing the rebuild on its own.
+        // Returns false and leaves the path alone unless the search has succeeded.
+        auto RebuildPath() noexcept -> bool;
+
+        // Initializes a new search. It fails without expanding anything if either end tile is off the grid or blocked.
         auto Initialize(Vector2 start, Vector2 end) noexcept -> void;
 
-        // Draws the completed path
-        auto DrawPath() noexcept -> void;
+        [[nodiscard]] auto GetGrid() const noexcept -> const Grid&;
+        [[nodiscard]] auto GetStart() const noexcept -> Vector2;
+        [[nodiscard]] auto GetEnd() const noexcept -> Vector2;
+
+        // Gets the state of the tile in the current search, for visualization
+        [[nodiscard]] auto GetTileState(Vector2 tile) const noexcept -> TileState;
+
+        // Gets the path completed by Update, from the start to the end tile
+        [[nodiscard]] auto GetPath() const noexcept -> const std::vector<Vector2>&;
+
+        // Gets the cost of the path completed by Update, infinity while there is none
+        [[nodiscard]] auto GetCost() const noexcept -> double;
+
+        // Gets the number of tiles the current search has expanded, by Update or FindPath, whether statistics are compiled in or not
+        [[nodiscard]] auto GetExpansions() const noexcept -> std::size_t;
+
+        // Gets the work done by the current search so far, all zero unless statistics are compiled in
+        [[nodiscard]] auto GetStatistics() const noexcept -> SearchStatistics;
 
     private:
-        // Reconstructs the completed path from the map
-        auto ReconstructPath(const Vector2& end) noexcept -> void;
-
-        // Checks if the tile is valid
-        auto IsValid(const Vector2& tile) noexcept -> bool;
-
-        // Manhattan distance to the end point
-        auto DistanceToEnd(const Vector2& tile) const noexcept -> double;
-
-        Area _area;
-        std::priority_queue<
-            std::pair<Vector2, double>,
-            std::vector<std::pair<Vector2, double>>,
-            std::greater<std::pair<Vector2, double>>
-        > _openSet;
-        std::unordered_set<Vector2> _closedSet;
-        std::unordered_map<Vector2, double> _gScore;
-        std::unordered_map<Vector2, double> _fScore;
-        std::unordered_map<Vector2, bool> _openSetResidency;
-        std::unordered_map<Vector2, Vector2> _cameFrom;
-        Vector2 _start, _end;
-        std::vector<Vector2> _obstacles;
-        std::stack<Vector2> _path;
+        // Expansions between clock reads in time-limited updates
+        static constexpr std::size_t TimeCheckInterval = 16;
 
-        std::vector<Vector2> _directions {
-            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }
+        // Search state of a single tile, stored densely in row-major order.
+        // Nodes stamped with an older generation belong to a previous search
+        // and are treated as unvisited. Open set membership is tracked by the heap.
+        struct Node {
+            double gScore;
+            double fScore;
+            int cameFrom;
+            unsigned int generation;
+            bool closed;
         };
+
+        // Nodes and open list of a search growing from one end of the path.
+        // A bidirectional search runs a second frontier backwards from the end tile.
+        struct Frontier {
+            std::variant<IndexedHeap<double>, BucketQueue> openSet;
+            std::vector<Node> nodes;
+            Vector2 target {};    // Tile the heuristic estimates the distance to
+            double bestCost = 0;  // Cheapest path through a tile both frontiers have reached
+            int meeting = -1;     // Tile that path runs through
+            bool settled = false; // Whether this frontier has proven the best path optimal
+            SearchStatistics statistics; // Counts of this frontier alone, so each thread only writes its own
+        };
+
+        // Expands tiles within the budget, returning how many were expanded
+        auto Run(const Budget& budget) noexcept -> std::size_t;
+
+        // Expands the next tile using the selected policy and open list
+        template<typename Policy, typename OpenSet>
+        auto Expand(OpenSet& openSet) noexcept -> Status;
+
+        // Expands the next tile of whichever frontier has the smaller open list
+        template<typename Policy, typename ForwardSet, typename BackwardSet>
+        auto ExpandBidirectional(ForwardSet& forward, BackwardSet& backward) noexcept -> Status;
+
+        // Expands the next tile of one frontier of a bidirectional search
+        template<typename Policy, typename OpenSet>
+        auto ExpandFrontier(Frontier& frontier, OpenSet& openSet) noexcept -> void;
+
+        // Searches both frontiers at once, the backward one on a second thread
+        auto RunConcurrently() noexcept -> void;
+
+        // Searches one frontier until either frontier has settled, returning how many tiles it expanded
+        template<typename Policy, typename OpenSet>
+        auto RunFrontier(Frontier& frontier, OpenSet& openSet, Frontier& opposite) noexcept -> std::size_t;
+
+        // Checks whether the frontier can no longer find a cheaper path than the best known one
+        template<typename OpenSet>
+        auto Settled(Frontier& frontier, OpenSet& openSet, Frontier& opposite) noexcept -> bool;
+
+        // Updates the tile if reaching it through the other tile is cheaper
+        template<typename Policy, typename OpenSet>
+        auto Relax(Frontier& frontier, OpenSet& openSet, int fromIndex, Vector2 to, double cost) noexcept -> void;
+
+        // Gets the direction the tile was entered from its parent in, zero for the start tile
+        [[nodiscard]] auto ArrivalDirection(int index) noexcept -> Vector2;
+
+        // Gets the node at the index, resetting it if it is stale
+        [[nodiscard]] auto NodeAt(Frontier& frontier, int index) noexcept -> Node&;
+
+        // Prepares a frontier growing from the origin for a new search
+        auto Reset(Frontier& frontier, Vector2 origin, Vector2 target) noexcept -> void;
+
+        // Gets the state of the tile in one frontier
+        [[nodiscard]] auto TileStateIn(const Frontier& frontier, int index) const noexcept -> TileState;
+
+        // Converts a position to its row-major index
+        [[nodiscard]] auto Index(Vector2 tile) const noexcept -> int;
+
+        // Converts an index back to a position
+        [[nodiscard]] auto PositionOf(int index) const noexcept -> Vector2;
+
+        // Reconstructs the completed path from the map
+        auto ReconstructPath(std::vector<Vector2>& path) const noexcept -> void;
+
+        // Marks the search finished and adds its statistics to those of the calling thread
+        auto RecordStatistics() noexcept -> void;
+
+        // Appends the tiles linked from the index back to the frontier's origin
+        auto AppendLinks(const Frontier& frontier, int index, std::vector<Vector2>& path) const noexcept -> void;
+
+        // Heuristic distance between two tiles, sharpened by the landmarks when they apply
+        template<typename Policy>
+        auto EstimateDistance(const Vector2& tile, const Vector2& target) const noexcept -> double;
+
+        // Heuristic distance between two tiles with the policy of the current search
+        auto EstimateDistance(const Vector2& tile, const Vector2& target) const noexcept -> double;
+
+        Frontier _forward;
+        Frontier _backward;
+        SearchOptions _options;
+        SearchOptions _search;      // Options of the current search, after falling back from what the grid cannot support
+        AnySearchPolicy _policy;    // Resolved from the options when a search starts
+        double _heuristicScale = 1; // Lowest terrain cost of the grid
+        double _costUnit = 1;       // Cost of a straight step in the units of the current search
+        unsigned int _generation = 0;
+        Status _status = Status::Error;
+        std::size_t _expansions = 0;
+        SearchStatistics _statistics; // Phase times of the current search, the frontiers count the rest
+        bool _bidirectional = false;
+        bool _concurrent = false; // Whether the frontiers are being searched on separate threads
+        Vector2 _start, _end;
+        std::shared_ptr<const Grid> _grid;
+        std::shared_ptr<const JumpTable> _jumpTable;
+        std::shared_ptr<const LandmarkTable> _landmarks;
+        bool _useLandmarks = false; // Whether the landmark costs bound the current search
+        std::vector<Vector2> _path;
     };
 } // namespace AStar
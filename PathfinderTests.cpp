@@ -0,0 +1,348 @@
+#include "DStarLite.hpp"
+#include "Grid.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "LandmarkTable.hpp"
+#include "MapGenerator.hpp"
+#include "Pathfinder.hpp"
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <queue>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace AStar;
+
+namespace {
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+    // Slack for comparing costs summed in different orders
+    constexpr double Tolerance = 1e-6;
+
+    // Queries run on every map
+    constexpr int QueryCount = 24;
+
+    // Highest ratio of an HPA* path's cost to the shortest one allowed on the seeded maps, as its header states
+    constexpr double MaximumDetour = 1.25;
+
+    // Seeded map all searches run on
+    struct Map {
+        std::string_view name;
+        std::shared_ptr<const Grid> grid;
+    };
+
+    // How a search mode's costs must compare to the shortest path
+    enum class Expectation {
+        Exact,      // Equal
+        AnyAngle,   // Never higher, as straight lines cut across the steps
+        NearOptimal // Never lower and at most MaximumDetour times higher
+    };
+
+    // Search mode under test, with the moves its reference path is measured with
+    struct Mode {
+        std::string_view name;
+        Neighbourhood neighbourhood;
+        double diagonalCost; // Cost of a diagonal step in the units the mode reports
+        Expectation expectation;
+        bool offGridEnds; // Whether the mode takes end tiles off the grid, D* Lite plans for an agent already on the map
+        std::function<Pathfinder::Result(const Map& map, Vector2 start, Vector2 end)> search;
+    };
+
+    int failures = 0;
+
+    auto Fail(const std::string_view mode, const Map& map, const Vector2 start, const Vector2 end, const char* message) -> void {
+        std::printf("FAIL %.*s on %.*s from (%d, %d) to (%d, %d): %s\n", static_cast<int>(mode.size()), mode.data(),
+            static_cast<int>(map.name.size()), map.name.data(), start.X, start.Y, end.X, end.Y, message);
+        ++failures;
+    }
+
+    auto Maps() -> std::vector<Map> {
+        constexpr Vector2 dimensions = { 97, 61 };
+
+        const auto share = [](Grid grid) {
+            return std::make_shared<const Grid>(std::move(grid));
+        };
+
+        return {
+            { "random obstacles", share(MapGenerator::RandomObstacles(dimensions, 0.3, 1)) },
+            { "recursive division", share(MapGenerator::RecursiveDivision(dimensions, 2)) },
+            { "depth first maze", share(MapGenerator::DepthFirstMaze(dimensions, 3)) },
+            { "caves", share(MapGenerator::Caves(dimensions, 4)) },
+            { "rooms and corridors", share(MapGenerator::RoomsAndCorridors(dimensions, 5, 24, 3, 12)) },
+            { "city blocks", share(MapGenerator::CityBlocks(dimensions, 6, 9, 2, 30, 0.2)) }
+        };
+    }
+
+    // Cost of the shortest path by plain Dijkstra, stepping as CanMove allows without cutting corners.
+    // Infinite if the end cannot be reached.
+    auto ShortestCost(const Grid& grid, const Vector2 start, const Vector2 end, const Neighbourhood neighbourhood, const double diagonalCost) -> double {
+        static constexpr Vector2 Directions[] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+
+        const PassabilityMap& passability = grid.GetPassability();
+        const int width = grid.Width();
+        const int directionCount = neighbourhood == Neighbourhood::Eight ? 8 : 4;
+
+        std::vector<double> costs(static_cast<std::size_t>(width) * grid.Height(), Infinity);
+        std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<>> open;
+
+        costs[start.Y * width + start.X] = 0;
+        open.push({ 0, start.Y * width + start.X });
+
+        while (!open.empty()) {
+            const auto [cost, index] = open.top();
+            open.pop();
+
+            if (cost > costs[index]) {
+                continue;
+            }
+
+            const Vector2 tile = { static_cast<short>(index % width), static_cast<short>(index / width) };
+
+            for (int i = 0; i < directionCount; ++i) {
+                const Vector2 direction = Directions[i];
+
+                if (!passability.CanMove(tile, direction)) {
+                    continue;
+                }
+
+                const int next = index + direction.Y * width + direction.X;
+                const double through = cost + (direction.X != 0 && direction.Y != 0 ? diagonalCost : 1) * grid.GetCost({ static_cast<short>(tile.X + direction.X), static_cast<short>(tile.Y + direction.Y) });
+
+                if (through < costs[next]) {
+                    costs[next] = through;
+                    open.push({ through, next });
+                }
+            }
+        }
+
+        return costs[end.Y * width + end.X];
+    }
+
+    // Sums the cost of a path of single steps, infinite if a step cannot be taken
+    auto StepPathCost(const Grid& grid, const std::vector<Vector2>& path, const Neighbourhood neighbourhood, const double diagonalCost) -> double {
+        double cost = 0;
+
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            const Vector2 direction = { static_cast<short>(path[i].X - path[i - 1].X), static_cast<short>(path[i].Y - path[i - 1].Y) };
+            const bool diagonal = direction.X != 0 && direction.Y != 0;
+
+            if (std::abs(direction.X) > 1 || std::abs(direction.Y) > 1 || (diagonal && neighbourhood == Neighbourhood::Four)
+                || !grid.GetPassability().CanMove(path[i - 1], direction)) {
+                return Infinity;
+            }
+
+            cost += (diagonal ? diagonalCost : 1) * grid.GetCost(path[i]);
+        }
+
+        return cost;
+    }
+
+    // Sums the straight-line lengths of a path of turning points, infinite if a line is blocked
+    auto AnyAnglePathCost(const Grid& grid, const std::vector<Vector2>& path) -> double {
+        double cost = 0;
+
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            if (!grid.GetPassability().HasLineOfSight(path[i - 1], path[i])) {
+                return Infinity;
+            }
+
+            cost += std::hypot(path[i].X - path[i - 1].X, path[i].Y - path[i - 1].Y);
+        }
+
+        return cost;
+    }
+
+    // Runs a standard Pathfinder with the options, sharing landmarks if there are any
+    auto Search(const SearchOptions& options, std::function<std::shared_ptr<const LandmarkTable>(const Map&)> landmarks = {}) {
+        return [options, landmarks](const Map& map, const Vector2 start, const Vector2 end) {
+            Pathfinder pathfinder(map.grid, options);
+
+            if (landmarks) {
+                pathfinder.SetLandmarks(landmarks(map));
+            }
+
+            return pathfinder.FindPath(start, end);
+        };
+    }
+
+    auto Modes() -> std::vector<Mode> {
+        constexpr double Diagonal = std::numbers::sqrt2;
+        constexpr double IntegerDiagonal = 99.0 / 70.0;
+
+        const auto landmarks = [](const Map& map) {
+            return std::make_shared<const LandmarkTable>(map.grid->GetPassability(), 6);
+        };
+
+        const auto hierarchical = [](const Neighbourhood neighbourhood) {
+            return [neighbourhood](const Map& map, const Vector2 start, const Vector2 end) {
+                HierarchicalPathfinder pathfinder(map.grid, 16, neighbourhood);
+                return pathfinder.FindPath(start, end);
+            };
+        };
+
+        const auto incremental = [](const Neighbourhood neighbourhood) {
+            return [neighbourhood](const Map& map, const Vector2 start, const Vector2 end) {
+                DStarLite planner(*map.grid, start, end, neighbourhood);
+                return planner.Plan();
+            };
+        };
+
+        return {
+            { "standard 4-connected heap", Neighbourhood::Four, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Four }) },
+            { "standard 4-connected buckets", Neighbourhood::Four, Diagonal, Expectation::Exact, true,
+                Search({ .openList = OpenList::Buckets, .neighbourhood = Neighbourhood::Four }) },
+            { "standard 8-connected heap", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight }) },
+            { "standard 8-connected integer buckets", Neighbourhood::Eight, IntegerDiagonal, Expectation::Exact, true,
+                Search({ .openList = OpenList::Buckets, .neighbourhood = Neighbourhood::Eight, .integerCosts = true }) },
+            { "bidirectional", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight, .direction = Direction::Bidirectional }) },
+            { "parallel bidirectional", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight, .direction = Direction::ParallelBidirectional }) },
+            { "jump point", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight, .expansion = Expansion::JumpPoint }) },
+            { "jump point plus", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight, .expansion = Expansion::JumpPointPlus }) },
+            { "landmarks", Neighbourhood::Eight, Diagonal, Expectation::Exact, true,
+                Search({ .neighbourhood = Neighbourhood::Eight }, landmarks) },
+            { "theta star", Neighbourhood::Eight, Diagonal, Expectation::AnyAngle, true,
+                Search({ .neighbourhood = Neighbourhood::Eight, .expansion = Expansion::ThetaStar }) },
+            { "d star lite 4-connected", Neighbourhood::Four, Diagonal, Expectation::Exact, false, incremental(Neighbourhood::Four) },
+            { "d star lite 8-connected", Neighbourhood::Eight, Diagonal, Expectation::Exact, false, incremental(Neighbourhood::Eight) },
+            { "hierarchical 4-connected", Neighbourhood::Four, Diagonal, Expectation::NearOptimal, true, hierarchical(Neighbourhood::Four) },
+            { "hierarchical 8-connected", Neighbourhood::Eight, Diagonal, Expectation::NearOptimal, true, hierarchical(Neighbourhood::Eight) }
+        };
+    }
+
+    // Draws passable tiles to search between, the same ones on every run
+    auto Queries(const Grid& grid) -> std::vector<std::pair<Vector2, Vector2>> {
+        std::mt19937 random(grid.Width() * 31 + grid.Height());
+        std::vector<Vector2> tiles;
+
+        while (tiles.size() < 2 * QueryCount) {
+            const Vector2 tile = { static_cast<short>(random() % grid.Width()), static_cast<short>(random() % grid.Height()) };
+
+            if (grid.GetPassability().IsPassable(tile)) {
+                tiles.push_back(tile);
+            }
+        }
+
+        std::vector<std::pair<Vector2, Vector2>> queries;
+
+        for (std::size_t i = 0; i < tiles.size(); i += 2) {
+            queries.push_back({ tiles[i], tiles[i + 1] });
+        }
+
+        return queries;
+    }
+
+    auto CheckPaths(const Mode& mode, const Map& map) -> void {
+        for (const auto& [start, end] : Queries(*map.grid)) {
+            const double shortest = ShortestCost(*map.grid, start, end, mode.neighbourhood, mode.diagonalCost);
+            const Pathfinder::Result result = mode.search(map, start, end);
+
+            if (shortest == Infinity) {
+                if (result.status != Pathfinder::Status::Error || !result.path.empty()) {
+                    Fail(mode.name, map, start, end, "found a path to an unreachable tile");
+                }
+
+                continue;
+            }
+
+            if (result.status != Pathfinder::Status::Success || result.path.empty()) {
+                Fail(mode.name, map, start, end, "found no path to a reachable tile");
+                continue;
+            }
+
+            if (result.path.front() != start || result.path.back() != end) {
+                Fail(mode.name, map, start, end, "path does not run between the end tiles");
+                continue;
+            }
+
+            const double walked = mode.expectation == Expectation::AnyAngle
+                ? AnyAnglePathCost(*map.grid, result.path)
+                : StepPathCost(*map.grid, result.path, mode.neighbourhood, mode.diagonalCost);
+
+            if (walked == Infinity || std::abs(walked - result.cost) > Tolerance) {
+                Fail(mode.name, map, start, end, "path is blocked or does not cost what was reported");
+                continue;
+            }
+
+            const bool withinBound = [&] {
+                switch (mode.expectation) {
+                case Expectation::Exact:
+                    return std::abs(result.cost - shortest) <= Tolerance;
+                case Expectation::AnyAngle:
+                    return result.cost <= shortest + Tolerance;
+                case Expectation::NearOptimal:
+                    return result.cost >= shortest - Tolerance && result.cost <= shortest * MaximumDetour + Tolerance;
+                }
+
+                return false;
+            }();
+
+            if (!withinBound) {
+                std::printf("  cost %.4f, shortest %.4f\n", result.cost, shortest);
+                Fail(mode.name, map, start, end, "path cost is out of bounds");
+            }
+        }
+    }
+
+    // Searches with an end tile blocked or off the grid must fail without a path
+    auto CheckInvalidEnds(const Mode& mode, const Map& map) -> void {
+        const Grid& grid = *map.grid;
+        const auto [open, other] = Queries(grid).front();
+
+        Vector2 blocked = open;
+
+        for (short y = 0; y < grid.Height() && grid.GetPassability().IsPassable(blocked); ++y) {
+            for (short x = 0; x < grid.Width() && grid.GetPassability().IsPassable(blocked); ++x) {
+                blocked = { x, y };
+            }
+        }
+
+        std::vector<std::pair<Vector2, Vector2>> invalid = { { blocked, open }, { open, blocked } };
+
+        if (mode.offGridEnds) {
+            for (const Vector2 outside : { Vector2{ -1, 0 }, Vector2{ 0, -1 }, Vector2{ grid.Width(), 0 }, Vector2{ 0, grid.Height() } }) {
+                invalid.push_back({ outside, open });
+                invalid.push_back({ open, outside });
+            }
+        }
+
+        for (const auto& [start, end] : invalid) {
+            const Pathfinder::Result result = mode.search(map, start, end);
+
+            if (result.status != Pathfinder::Status::Error || !result.path.empty()) {
+                Fail(mode.name, map, start, end, "found a path from or to a blocked tile or one off the grid");
+            }
+        }
+    }
+}
+
+// Runs every search mode on the seeded maps and checks the paths against plain Dijkstra.
+// Prints each failure and returns nonzero if there was any.
+int main() {
+    const std::vector<Map> maps = Maps();
+    const std::vector<Mode> modes = Modes();
+
+    for (const Mode& mode : modes) {
+        const int before = failures;
+
+        for (const Map& map : maps) {
+            CheckPaths(mode, map);
+            CheckInvalidEnds(mode, map);
+        }
+
+        std::printf("%s %.*s\n", failures == before ? "ok  " : "FAIL", static_cast<int>(mode.name.size()), mode.name.data());
+    }
+
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
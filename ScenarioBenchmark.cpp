@@ -0,0 +1,235 @@
+#include "LandmarkTable.hpp"
+#include "MovingAi.hpp"
+#include "Pathfinder.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace AStar;
+
+namespace {
+    // Settings taken from the command line
+    struct Settings {
+        SearchOptions options { .neighbourhood = Neighbourhood::Eight };
+        int landmarks = 0;
+        std::filesystem::path maps; // Directory the maps are looked up in, next to each scenario file if empty
+        std::vector<std::filesystem::path> scenarios;
+    };
+
+    // Outcome of the queries of one scenario file, or of all of them
+    struct Summary {
+        std::size_t queries = 0;
+        std::size_t solved = 0;
+        std::size_t wrong = 0;   // Unsolved, or longer than the optimal length, or shorter for searches on the grid
+        std::size_t shorter = 0; // Shorter than the optimal length, which any-angle paths can be
+        std::size_t expansions = 0;
+        std::vector<double> latencies; // Microseconds per query
+    };
+
+    // Reference lengths are printed with a few decimals, integer costs round diagonals slightly
+    constexpr double Tolerance = 1e-4;
+
+    auto PrintUsage() -> void {
+        std::fprintf(stderr,
+            "Usage: ScenarioBenchmark [options] <file.scen>...\n"
+            "  --expansion standard|jps|jps+|theta\n"
+            "  --open heap|buckets\n"
+            "  --direction forward|bidirectional|parallel\n"
+            "  --heuristic automatic|manhattan|octile|euclidean|chebyshev\n"
+            "  --integer            Scale step costs to whole numbers\n"
+            "  --landmarks <count>  Sharpen the heuristic with a landmark table per map\n"
+            "  --maps <directory>   Look the maps up in the directory instead of next to the scenarios\n");
+    }
+
+    // Finds the index of the value in the names, returning false if it is not one of them
+    template<typename Enum, std::size_t Count>
+    auto ParseChoice(const std::string_view value, const std::string_view (&names)[Count], Enum& choice) -> bool {
+        const auto found = std::ranges::find(names, value);
+
+        if (found == std::end(names)) {
+            return false;
+        }
+
+        choice = static_cast<Enum>(found - std::begin(names));
+        return true;
+    }
+
+    auto ParseArguments(const int argc, char** argv, Settings& settings) -> bool {
+        static constexpr std::string_view Expansions[] = { "standard", "jps", "jps+", "theta" };
+        static constexpr std::string_view OpenLists[] = { "heap", "buckets" };
+        static constexpr std::string_view Directions[] = { "forward", "bidirectional", "parallel" };
+        static constexpr std::string_view Heuristics[] = { "automatic", "manhattan", "octile", "euclidean", "chebyshev" };
+
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (argument == "--integer") {
+                settings.options.integerCosts = true;
+            }
+            else if (!argument.starts_with("--")) {
+                settings.scenarios.emplace_back(argument);
+            }
+            else if (!hasValue) {
+                return false;
+            }
+            else if (argument == "--expansion") {
+                if (!ParseChoice(argv[++i], Expansions, settings.options.expansion)) {
+                    return false;
+                }
+            }
+            else if (argument == "--open") {
+                if (!ParseChoice(argv[++i], OpenLists, settings.options.openList)) {
+                    return false;
+                }
+            }
+            else if (argument == "--direction") {
+                if (!ParseChoice(argv[++i], Directions, settings.options.direction)) {
+                    return false;
+                }
+            }
+            else if (argument == "--heuristic") {
+                if (!ParseChoice(argv[++i], Heuristics, settings.options.heuristic)) {
+                    return false;
+                }
+            }
+            else if (argument == "--landmarks") {
+                const std::string_view value = argv[++i];
+                const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), settings.landmarks);
+
+                if (error != std::errc{} || end != value.data() + value.size() || settings.landmarks < 0) {
+                    return false;
+                }
+            }
+            else if (argument == "--maps") {
+                settings.maps = argv[++i];
+            }
+            else {
+                return false;
+            }
+        }
+
+        return !settings.scenarios.empty();
+    }
+
+    // Tries the map's path under the lookup directory, then its bare file name there
+    auto LoadMap(const Settings& settings, const std::filesystem::path& scenarioFile, const std::filesystem::path& map, Grid& grid) -> bool {
+        const std::filesystem::path directory = settings.maps.empty() ? scenarioFile.parent_path() : settings.maps;
+        return MovingAi::LoadMap(directory / map, grid) || MovingAi::LoadMap(directory / map.filename(), grid);
+    }
+
+    auto Percentile(const std::vector<double>& sorted, const double fraction) -> double {
+        if (sorted.empty()) {
+            return 0;
+        }
+
+        const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    auto Print(const std::string& name, Summary& summary) -> void {
+        std::ranges::sort(summary.latencies);
+
+        std::printf("%-40s queries %7zu  solved %7zu  wrong %5zu  shorter %5zu  expansions %12zu  "
+            "latency us p50 %9.1f  p90 %9.1f  p99 %9.1f  max %9.1f\n",
+            name.c_str(), summary.queries, summary.solved, summary.wrong, summary.shorter, summary.expansions,
+            Percentile(summary.latencies, 0.5), Percentile(summary.latencies, 0.9),
+            Percentile(summary.latencies, 0.99), summary.latencies.empty() ? 0.0 : summary.latencies.back());
+    }
+
+    // Merges the counts of one summary into another
+    auto Add(Summary& total, const Summary& summary) -> void {
+        total.queries += summary.queries;
+        total.solved += summary.solved;
+        total.wrong += summary.wrong;
+        total.shorter += summary.shorter;
+        total.expansions += summary.expansions;
+        total.latencies.insert(total.latencies.end(), summary.latencies.begin(), summary.latencies.end());
+    }
+}
+
+// Runs every query of Moving AI scenario files through the search, checking the path lengths
+// against the optimal ones and reporting expansions and latency percentiles.
+// Exits with 1 if any query is answered wrongly and with 2 if the input cannot be read.
+int main(const int argc, char** argv) {
+    Settings settings;
+
+    if (!ParseArguments(argc, argv, settings)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Any-angle paths may undercut the 8-connected optimum, never exceed it
+    const bool anyAngle = settings.options.expansion == Expansion::ThetaStar;
+
+    Summary total;
+
+    for (const std::filesystem::path& scenarioFile : settings.scenarios) {
+        std::vector<Scenario> scenarios;
+
+        if (!MovingAi::LoadScenarios(scenarioFile, scenarios)) {
+            std::fprintf(stderr, "Cannot read scenarios from %s\n", scenarioFile.string().c_str());
+            return 2;
+        }
+
+        Summary summary;
+        std::filesystem::path loadedMap;
+        Pathfinder pathfinder;
+
+        for (const Scenario& scenario : scenarios) {
+            // Scenario files usually stick to one map, so it is only loaded again when it changes
+            if (scenario.map != loadedMap) {
+                Grid grid;
+
+                if (!LoadMap(settings, scenarioFile, scenario.map, grid)
+                    || grid.Width() != scenario.dimensions.X || grid.Height() != scenario.dimensions.Y) {
+                    std::fprintf(stderr, "Cannot read map %s for %s\n", scenario.map.string().c_str(), scenarioFile.string().c_str());
+                    return 2;
+                }
+
+                const auto shared = std::make_shared<const Grid>(std::move(grid));
+                pathfinder = Pathfinder(shared, settings.options);
+
+                if (settings.landmarks > 0) {
+                    pathfinder.SetLandmarks(std::make_shared<const LandmarkTable>(shared->GetPassability(), settings.landmarks));
+                }
+
+                loadedMap = scenario.map;
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            const Pathfinder::Result result = pathfinder.FindPath(scenario.start, scenario.end);
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+
+            summary.expansions += pathfinder.GetExpansions();
+
+            const double tolerance = Tolerance * std::max(1.0, scenario.optimalLength);
+            const bool solved = result.status == Pathfinder::Status::Success;
+            const bool shorter = solved && result.cost < scenario.optimalLength - tolerance;
+            const bool longer = solved && result.cost > scenario.optimalLength + tolerance;
+
+            ++summary.queries;
+            summary.solved += solved;
+            summary.shorter += shorter;
+            summary.wrong += !solved || longer || (shorter && !anyAngle);
+            summary.latencies.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+        }
+
+        Add(total, summary);
+        Print(scenarioFile.filename().string(), summary);
+    }
+
+    if (settings.scenarios.size() > 1) {
+        Print("total", total);
+    }
+
+    return total.wrong > 0 ? 1 : 0;
+}
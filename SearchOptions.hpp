@@ -0,0 +1,69 @@
+#pragma once
+
+namespace AStar {
+    // Open list implementations the search can run on
+    enum class OpenList {
+        BinaryHeap, // Indexed binary heap, exact for any scores
+        Buckets     // Bucket queue, O(1) amortized but only exact when every score is an integer,
+                    // so 8-connected searches use the binary heap unless they also set integerCosts
+    };
+
+    // Tiles reachable in a single step
+    enum class Neighbourhood {
+        Four, // Cardinal moves only
+        Eight // Cardinal and diagonal moves, diagonals pass blocked corners as the corner cutting rule allows
+    };
+
+    // Blocked tiles a diagonal step may pass between, the tiles beside it on the way to the tile it enters
+    enum class CornerCutting {
+        Never,   // Both tiles beside the step must be passable
+        OneSide, // One tile beside the step may be blocked, but not both
+        Always   // Only the tile entered must be passable, squeezing between two blocked tiles
+    };
+
+    // How successors of an expanded tile are generated
+    enum class Expansion {
+        Standard, // Every valid neighbour
+        JumpPoint,    // Jump point search, always moves 8-connected and assumes uniform costs without corner cutting.
+                      // On grids with terrain costs or with corners cut the search expands every 8-connected neighbour instead.
+        JumpPointPlus, // Jump point search reading jumps from a precomputed JumpTable instead of scanning
+        ThetaStar      // Any-angle search, 8-connected but linking each tile straight to its grandparent when the line
+                       // between them is clear. Paths only hold the tiles they turn at and cost their straight-line length,
+                       // so integerCosts is ignored and the binary heap is used. Corners are never cut, as lines of sight do not.
+                       // On grids with terrain costs the search expands every 8-connected neighbour instead.
+    };
+
+    // Estimate of the remaining cost that steers the search towards the end tile
+    enum class Heuristic {
+        Automatic, // Manhattan for 4-connected standard searches, Euclidean for Theta*, octile otherwise
+        Manhattan, // Exact on an open 4-connected grid, overestimates diagonal moves and may lose the shortest path
+        Octile,    // Exact on an open 8-connected grid
+        Euclidean, // Straight-line distance, never overestimates but expands more tiles
+        Chebyshev  // Prices diagonal moves like straight ones, never overestimates but expands more tiles
+    };
+
+    // Ends of the path the search grows from, only used with standard expansion
+    enum class Direction {
+        Forward,              // From the start tile towards the end tile
+        Bidirectional,        // From both ends in turn until the two frontiers meet
+        ParallelBidirectional // From both ends on two threads in FindPath, in turn in Update
+    };
+
+    // Settings applied to the next search started with Pathfinder::Initialize
+    struct SearchOptions {
+        OpenList openList = OpenList::BinaryHeap;
+        Neighbourhood neighbourhood = Neighbourhood::Four;
+        Expansion expansion = Expansion::Standard;
+        Direction direction = Direction::Forward;
+        Heuristic heuristic = Heuristic::Automatic;
+        CornerCutting cornerCutting = CornerCutting::Never;
+
+        // Scales step costs to whole numbers, straight steps to 70 and diagonals to 99, and heuristics alike.
+        // Costs are reported in tiles again, diagonals then count 99 / 70 instead of the square root of two.
+        bool integerCosts = false;
+
+        // Pulls finished paths taut with PathSmoother, so they only hold the tiles they turn at.
+        // The reported cost stays that of the path the search found.
+        bool smoothPaths = false;
+    };
+} // namespace AStar
@@ -0,0 +1,32 @@
+#include "SearchPolicies.hpp"
+#include <utility>
+
+namespace AStar {
+    auto SelectPolicy(const SearchOptions& options, const Grid& grid) noexcept -> AnySearchPolicy {
+        const bool eightConnected = options.neighbourhood == Neighbourhood::Eight || options.expansion != Expansion::Standard;
+
+        Heuristic heuristic = options.heuristic;
+
+        // Octile distances overestimate the straight lines of any-angle paths
+        if (heuristic == Heuristic::Automatic) {
+            heuristic = options.expansion == Expansion::ThetaStar ? Heuristic::Euclidean
+                : eightConnected ? Heuristic::Octile
+                : Heuristic::Manhattan;
+        }
+
+        const std::size_t distance = static_cast<std::size_t>(heuristic) - 1;
+        const std::size_t connectivity = eightConnected ? 1 : 0;
+
+        // 4-connected steps are whole already, any-angle ones never are
+        const bool integerCosts = options.integerCosts && eightConnected && options.expansion != Expansion::ThetaStar;
+        const std::size_t cost = (grid.HasTerrainCosts() ? 2 : 0) + (integerCosts ? 1 : 0);
+
+        const std::size_t index = (cost * std::tuple_size_v<Distances> + distance) * std::tuple_size_v<Connectivities> + connectivity;
+
+        static constexpr auto Factories = []<std::size_t... Indices>(std::index_sequence<Indices...>) {
+            return std::array { +[]() noexcept { return AnySearchPolicy(std::in_place_index<Indices>); }... };
+        }(std::make_index_sequence<std::variant_size_v<AnySearchPolicy>>());
+
+        return Factories[index]();
+    }
+} // namespace AStar
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include "Grid.hpp"
+#include "SearchOptions.hpp"
+#include "Vector2.hpp"
+
+namespace AStar {
+    // Policies the search loop is compiled for, so the heuristic, the neighbour loop and the
+    // step costs of every configuration are inlined instead of being branched on for each tile.
+
+    // Step lengths in tile units
+    struct ExactUnits {
+        static constexpr bool Integer = false;
+        static constexpr double Straight = 1;
+        static constexpr double Diagonal = std::numbers::sqrt2;
+    };
+
+    // Step lengths scaled to integers, so every score is whole and bucket queues stay exact.
+    // 99 / 70 is within 0.005% of the square root of two.
+    struct IntegerUnits {
+        static constexpr bool Integer = true;
+        static constexpr double Straight = 70;
+        static constexpr double Diagonal = 99;
+    };
+
+    // Distance exact on an open 4-connected grid
+    struct ManhattanDistance {
+        template<typename Units>
+        static constexpr auto Estimate(const Vector2 from, const Vector2 to) noexcept -> double {
+            return Units::Straight * (std::abs(from.X - to.X) + std::abs(from.Y - to.Y));
+        }
+    };
+
+    // Distance exact on an open 8-connected grid
+    struct OctileDistance {
+        template<typename Units>
+        static constexpr auto Estimate(const Vector2 from, const Vector2 to) noexcept -> double {
+            const int dx = std::abs(from.X - to.X);
+            const int dy = std::abs(from.Y - to.Y);
+            return Units::Straight * std::max(dx, dy) + (Units::Diagonal - Units::Straight) * std::min(dx, dy);
+        }
+    };
+
+    // Straight-line distance, rounded down to stay whole in integer units
+    struct EuclideanDistance {
+        template<typename Units>
+        static auto Estimate(const Vector2 from, const Vector2 to) noexcept -> double {
+            const int dx = from.X - to.X;
+            const int dy = from.Y - to.Y;
+            const double distance = Units::Straight * std::sqrt(dx * dx + dy * dy);
+            return Units::Integer ? std::floor(distance) : distance;
+        }
+    };
+
+    // Distance with diagonal moves as cheap as straight ones
+    struct ChebyshevDistance {
+        template<typename Units>
+        static constexpr auto Estimate(const Vector2 from, const Vector2 to) noexcept -> double {
+            return Units::Straight * std::max(std::abs(from.X - to.X), std::abs(from.Y - to.Y));
+        }
+    };
+
+    // Cardinal moves only
+    struct FourConnected {
+        static constexpr std::array<Vector2, 4> Directions { {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }
+        } };
+    };
+
+    // Cardinal moves followed by the diagonals
+    struct EightConnected {
+        static constexpr std::array<Vector2, 8> Directions { {
+            { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+            { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+        } };
+    };
+
+    // Every passable tile costs the same to enter, diagonals cost their length
+    template<typename UnitsType>
+    struct UniformCost {
+        using Units = UnitsType;
+        static constexpr bool Uniform = true;
+
+        static constexpr auto StepCost(const Grid&, Vector2, const Vector2 direction) noexcept -> double {
+            return direction.X != 0 && direction.Y != 0 ? Units::Diagonal : Units::Straight;
+        }
+    };
+
+    // Steps cost their length times the terrain cost of the tile they enter.
+    // Distances are scaled by the cheapest terrain cost to stay admissible.
+    template<typename UnitsType>
+    struct WeightedCost {
+        using Units = UnitsType;
+        static constexpr bool Uniform = false;
+
+        static auto StepCost(const Grid& grid, const Vector2 entered, const Vector2 direction) noexcept -> double {
+            return UniformCost<Units>::StepCost(grid, entered, direction) * grid.GetCost(entered);
+        }
+    };
+
+    // One combination of a distance, a neighbourhood and a cost policy
+    template<typename DistanceType, typename ConnectivityType, typename CostType>
+    struct SearchPolicy {
+        using Distance = DistanceType;
+        using Connectivity = ConnectivityType;
+        using Cost = CostType;
+    };
+
+    // Choices for each part of a policy, in the order of the options selecting them
+    using Distances = std::tuple<ManhattanDistance, OctileDistance, EuclideanDistance, ChebyshevDistance>;
+    using Connectivities = std::tuple<FourConnected, EightConnected>;
+    using Costs = std::tuple<UniformCost<ExactUnits>, UniformCost<IntegerUnits>, WeightedCost<ExactUnits>, WeightedCost<IntegerUnits>>;
+
+    // Combination at the index, counting through the connectivities fastest and the costs slowest
+    template<std::size_t Index>
+    using PolicyAt = SearchPolicy<
+        std::tuple_element_t<Index / std::tuple_size_v<Connectivities> % std::tuple_size_v<Distances>, Distances>,
+        std::tuple_element_t<Index % std::tuple_size_v<Connectivities>, Connectivities>,
+        std::tuple_element_t<Index / (std::tuple_size_v<Connectivities> * std::tuple_size_v<Distances>), Costs>>;
+
+    // Every combination
+    using AnySearchPolicy = decltype([]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        return std::variant<PolicyAt<Indices>...>();
+    }(std::make_index_sequence<std::tuple_size_v<Distances> * std::tuple_size_v<Connectivities> * std::tuple_size_v<Costs>>()));
+
+    // Picks the combination the options ask for, with terrain costs only if the grid has any.
+    // Jump point and Theta* searches always move 8-connected, whatever neighbourhood the options name.
+    [[nodiscard]] auto SelectPolicy(const SearchOptions& options, const Grid& grid) noexcept -> AnySearchPolicy;
+} // namespace AStar
@@ -0,0 +1,35 @@
+#include "SearchStatistics.hpp"
+#include <algorithm>
+
+namespace AStar {
+    namespace {
+        thread_local SearchStatistics threadStatistics;
+    }
+
+    auto SearchStatistics::operator+=(const SearchStatistics& other) noexcept -> SearchStatistics& {
+        searches += other.searches;
+        expanded += other.expanded;
+        pushed += other.pushed;
+        reopened += other.reopened;
+        updated += other.updated;
+        discarded += other.discarded;
+        peakOpen = std::max(peakOpen, other.peakOpen);
+        searchTime += other.searchTime;
+        reconstructTime += other.reconstructTime;
+        return *this;
+    }
+
+    auto GetThreadStatistics() noexcept -> const SearchStatistics& {
+        return threadStatistics;
+    }
+
+    auto RecordThreadStatistics(const SearchStatistics& statistics) noexcept -> void {
+        if constexpr (StatisticsEnabled) {
+            threadStatistics += statistics;
+        }
+    }
+
+    auto ResetThreadStatistics() noexcept -> void {
+        threadStatistics = {};
+    }
+} // namespace AStar
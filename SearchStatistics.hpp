@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace AStar {
+    // Whether the counters are compiled in, set with the ASTAR_STATISTICS build option.
+    // Without it every counter stays zero and the code updating them compiles away.
+#ifdef ASTAR_STATISTICS
+    inline constexpr bool StatisticsEnabled = true;
+#else
+    inline constexpr bool StatisticsEnabled = false;
+#endif
+
+    // Work done by searches, for a single query or summed over many
+    struct SearchStatistics {
+        std::size_t searches = 0;  // Searches finished
+        std::size_t expanded = 0;  // Tiles taken off an open list and expanded
+        std::size_t pushed = 0;    // Tiles put on an open list, reopened ones included
+        std::size_t reopened = 0;  // Closed tiles put back on an open list after a cheaper route was found
+        std::size_t updated = 0;   // Open tiles whose score was lowered in place
+        std::size_t discarded = 0; // Routes to a tile dropped for being no cheaper than the known one
+        std::size_t peakOpen = 0;  // Most tiles waiting in an open list at once, summed over both frontiers of a bidirectional search
+        std::chrono::nanoseconds searchTime {};      // Spent expanding tiles
+        std::chrono::nanoseconds reconstructTime {}; // Spent following the links back into a path
+
+        // Adds the counts and times of another search, keeping the larger peak
+        auto operator+=(const SearchStatistics& other) noexcept -> SearchStatistics&;
+    };
+
+    // Adds the time from its creation until it goes out of scope to a total, if statistics are compiled in
+    class StatisticsTimer final {
+    public:
+        explicit StatisticsTimer(std::chrono::nanoseconds& total) noexcept;
+        ~StatisticsTimer() noexcept;
+
+        StatisticsTimer(const StatisticsTimer&) = delete;
+        auto operator=(const StatisticsTimer&) -> StatisticsTimer& = delete;
+
+    private:
+        std::chrono::nanoseconds& _total;
+        std::chrono::steady_clock::time_point _started;
+    };
+
+    // Defined inline, so the timer vanishes entirely when statistics are compiled out
+    inline StatisticsTimer::StatisticsTimer(std::chrono::nanoseconds& total) noexcept : _total(total) {
+        if constexpr (StatisticsEnabled) {
+            _started = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline StatisticsTimer::~StatisticsTimer() noexcept {
+        if constexpr (StatisticsEnabled) {
+            _total += std::chrono::steady_clock::now() - _started;
+        }
+    }
+
+    // Gets the sum over every search finished on the calling thread since the last reset.
+    // A search resumed across threads counts towards the thread it finishes on.
+    [[nodiscard]] auto GetThreadStatistics() noexcept -> const SearchStatistics&;
+
+    // Adds a finished search to the sum of the calling thread
+    auto RecordThreadStatistics(const SearchStatistics& statistics) noexcept -> void;
+
+    // Clears the sum of the calling thread
+    auto ResetThreadStatistics() noexcept -> void;
+} // namespace AStar
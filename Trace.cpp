@@ -0,0 +1,202 @@
+#include "Trace.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace AStar {
+    namespace {
+        struct Event {
+            const char* name;
+            std::int64_t started; // Nanoseconds on the steady clock
+            std::int64_t duration;
+        };
+
+        // Block of events that never moves once allocated, so it can be read while its thread appends to it
+        struct Chunk {
+            static constexpr std::size_t Capacity = 4096;
+
+            std::array<Event, Capacity> events;
+            std::atomic<std::size_t> count = 0; // Events published to readers
+            std::atomic<Chunk*> next = nullptr;
+        };
+
+        // Events of one thread, only ever appended to by that thread
+        struct ThreadBuffer {
+            explicit ThreadBuffer(const int id) noexcept : thread(id), head(std::make_unique<Chunk>()), tail(head.get()) {
+
+            }
+
+            ~ThreadBuffer() noexcept {
+                for (Chunk* chunk = head->next.load(std::memory_order_relaxed); chunk != nullptr;) {
+                    delete std::exchange(chunk, chunk->next.load(std::memory_order_relaxed));
+                }
+            }
+
+            int thread;
+            std::unique_ptr<Chunk> head;
+            Chunk* tail;
+            std::size_t cleared = 0; // Leading events of the head chunk dropped by Clear, guarded by the buffer list's mutex
+            bool inUse = true; // Whether a running thread appends to it, guarded by the buffer list's mutex
+        };
+
+        // Buffers outlive their threads, so events of threads that have exited are still written
+        std::mutex buffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        // Hands the buffer on when its thread exits, so short-lived threads like the backward
+        // searches of parallel bidirectional queries take turns on a few buffers
+        struct BufferLease {
+            ~BufferLease() noexcept {
+                if (buffer != nullptr) {
+                    std::lock_guard lock(buffersMutex);
+                    buffer->inUse = false;
+                }
+            }
+
+            ThreadBuffer* buffer = nullptr;
+        };
+
+        auto LocalBuffer() noexcept -> ThreadBuffer& {
+            thread_local BufferLease lease;
+
+            if (lease.buffer == nullptr) {
+                std::lock_guard lock(buffersMutex);
+                const auto idle = std::ranges::find_if(buffers, [](const auto& buffer) { return !buffer->inUse; });
+
+                if (idle != buffers.end()) {
+                    lease.buffer = idle->get();
+                    lease.buffer->inUse = true;
+                }
+                else {
+                    buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<int>(buffers.size()) + 1));
+                    lease.buffer = buffers.back().get();
+                }
+            }
+
+            return *lease.buffer;
+        }
+
+        // Writes a string as JSON, escaping the characters that would end it early
+        auto WriteString(std::ofstream& file, const char* text) noexcept -> void {
+            file << '"';
+
+            for (; *text != '\0'; ++text) {
+                if (*text == '"' || *text == '\\') {
+                    file << '\\';
+                }
+
+                file << *text;
+            }
+
+            file << '"';
+        }
+
+        // Writes nanoseconds as the microseconds the format expects, keeping the fraction
+        auto WriteMicroseconds(std::ofstream& file, const std::int64_t nanoseconds) noexcept -> void {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%lld.%03lld",
+                static_cast<long long>(nanoseconds / 1000), static_cast<long long>(nanoseconds % 1000));
+            file << text;
+        }
+    }
+
+    auto Trace::Enable(const bool enabled) noexcept -> void {
+        Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    auto Trace::Record(const char* name, const std::chrono::steady_clock::time_point started,
+        const std::chrono::steady_clock::time_point ended) noexcept -> void {
+        ThreadBuffer& buffer = LocalBuffer();
+        Chunk* chunk = buffer.tail;
+        std::size_t count = chunk->count.load(std::memory_order_relaxed);
+
+        if (count == Chunk::Capacity) {
+            Chunk* next = new Chunk();
+            chunk->next.store(next, std::memory_order_release);
+            buffer.tail = chunk = next;
+            count = 0;
+        }
+
+        chunk->events[count] = {
+            name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch()).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(ended - started).count()
+        };
+
+        chunk->count.store(count + 1, std::memory_order_release);
+    }
+
+    auto Trace::WriteChromeTrace(const std::filesystem::path& path) noexcept -> bool {
+        std::ofstream file(path, std::ios::trunc);
+
+        if (!file) {
+            return false;
+        }
+
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+
+        // Holding the lock only keeps new threads from registering, the threads themselves record on
+        std::lock_guard lock(buffersMutex);
+
+        for (const auto& buffer : buffers) {
+            file << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread
+                << ",\"args\":{\"name\":\"Thread " << buffer->thread << "\"}}";
+            first = false;
+
+            // Only events recorded before the write reached the buffer are written,
+            // so threads that keep recording cannot make the write chase them forever
+            const Chunk* last = buffer->head.get();
+
+            while (const Chunk* next = last->next.load(std::memory_order_acquire)) {
+                last = next;
+            }
+
+            const std::size_t lastCount = last->count.load(std::memory_order_acquire);
+
+            for (const Chunk* chunk = buffer->head.get();; chunk = chunk->next.load(std::memory_order_acquire)) {
+                const std::size_t count = chunk == last ? lastCount : chunk->count.load(std::memory_order_acquire);
+
+                for (std::size_t i = chunk == buffer->head.get() ? buffer->cleared : 0; i < count; ++i) {
+                    const Event& event = chunk->events[i];
+
+                    file << ",\n{\"name\":";
+                    WriteString(file, event.name);
+                    file << ",\"cat\":\"AStar\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread << ",\"ts\":";
+                    WriteMicroseconds(file, event.started);
+                    file << ",\"dur\":";
+                    WriteMicroseconds(file, event.duration);
+                    file << '}';
+                }
+
+                if (chunk == last) {
+                    break;
+                }
+            }
+        }
+
+        file << "\n]}\n";
+
+        return static_cast<bool>(file);
+    }
+
+    auto Trace::Clear() noexcept -> void {
+        std::lock_guard lock(buffersMutex);
+
+        for (const auto& buffer : buffers) {
+            // A thread stops touching a chunk once it has linked the next one, so every chunk but
+            // the last can be freed. The last one may still be appended to, its events are skipped instead.
+            while (Chunk* next = buffer->head->next.load(std::memory_order_acquire)) {
+                buffer->head.reset(next);
+            }
+
+            buffer->cleared = buffer->head->count.load(std::memory_order_acquire);
+        }
+    }
+} // namespace AStar
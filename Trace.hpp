@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+namespace AStar {
+    // Whether tracing is compiled in, cleared by turning off the ASTAR_TRACING build option.
+    // Without it every scope compiles away, with it a scope costs one relaxed load while tracing is off.
+#ifdef ASTAR_TRACING
+    inline constexpr bool TracingCompiled = true;
+#else
+    inline constexpr bool TracingCompiled = false;
+#endif
+
+    // Records timed scopes on any thread for viewing in chrome://tracing or Perfetto.
+    // Each thread appends to its own buffer without locking, only a thread's first event takes a lock.
+    class Trace final {
+    public:
+        // Starts or stops recording new scopes
+        static auto Enable(bool enabled) noexcept -> void;
+
+        [[nodiscard]] static auto IsEnabled() noexcept -> bool;
+
+        // Adds a finished scope to the calling thread's buffer
+        static auto Record(const char* name, std::chrono::steady_clock::time_point started,
+            std::chrono::steady_clock::time_point ended) noexcept -> void;
+
+        // Writes every event recorded so far in the Chrome trace event format.
+        // Threads may keep recording meanwhile, events they finish during the write may be left out.
+        // Returns false if the file cannot be written.
+        static auto WriteChromeTrace(const std::filesystem::path& path) noexcept -> bool;
+
+        // Drops every event recorded so far and frees the memory they held, so long runs can write
+        // their trace piece by piece. Events threads finish during the call may be dropped as well.
+        static auto Clear() noexcept -> void;
+
+    private:
+        inline static std::atomic<bool> Enabled = false;
+    };
+
+    // Records the time from its creation until it goes out of scope as an event, while tracing is enabled.
+    // The name has to outlive the trace, normally it is a string literal.
+    class TraceScope final {
+    public:
+        explicit TraceScope(const char* name) noexcept;
+        ~TraceScope() noexcept;
+
+        TraceScope(const TraceScope&) = delete;
+        auto operator=(const TraceScope&) -> TraceScope& = delete;
+
+    private:
+        const char* _name = nullptr; // Left empty when tracing was off as the scope began
+        std::chrono::steady_clock::time_point _started;
+    };
+
+    inline auto Trace::IsEnabled() noexcept -> bool {
+        return TracingCompiled && Enabled.load(std::memory_order_relaxed);
+    }
+
+    // Defined inline, so a scope is a single check while tracing is off and nothing when it is compiled out
+    inline TraceScope::TraceScope(const char* name) noexcept {
+        if (Trace::IsEnabled()) {
+            _name = name;
+            _started = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline TraceScope::~TraceScope() noexcept {
+        if (TracingCompiled && _name != nullptr) {
+            Trace::Record(_name, _started, std::chrono::steady_clock::now());
+        }
+    }
+} // namespace AStar
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace AStar {
+    // Tile coordinate on the grid
+    struct Vector2 {
+        short X;
+        short Y;
+
+        auto operator==(const Vector2& other) const noexcept -> bool = default;
+    };
+} // namespace AStar
@@ -3,5 +3,3 @@
 #define UNICODE
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
-
-using Vector2 = COORD;
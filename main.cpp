@@ -1,11 +1,18 @@
+#include "Area.hpp"
 #include "Console.hpp"
 #include "Pathfinder.hpp"
+#include "Trace.hpp"
 #include "Windows.hpp"
 #include <random>
+#include <string_view>
 
 using namespace AStar;
 
-int main() {
+int main(const int argc, char** argv) {
+    // With "--trace <file>" every frame is traced and the trace of each path replaces the previous one in the file
+    const bool tracing = argc > 2 && std::string_view(argv[1]) == "--trace";
+    Trace::Enable(tracing);
+
     // Create screen buffers for drawing
     Console::CreateBuffers();
 
@@ -17,8 +24,9 @@ int main() {
         { 13, 12 }, { 14, 12 }, { 15, 12 }, { 16, 12 }, { 17, 12 }, { 13, 13 }, { 13, 14 }, { 13, 15 }, { 13, 16 }
     };
 
-    // Creating the pathfinder
+    // Creating the pathfinder and the area it is drawn to
     Pathfinder pathfinder({ 20, 20 }, obstacles, std::size(obstacles));
+    Area area({ 20, 20 }, L' ');
 
     // Random distributions for the end points
     std::random_device device;
@@ -37,6 +45,8 @@ int main() {
             Console::Clear();
             switch (pathfinder.Update()) {
             case Pathfinder::Status::InProgress:
+                area.DrawSearch(pathfinder);
+                area.Render();
                 break;
 
             case Pathfinder::Status::Success:
@@ -55,9 +65,15 @@ int main() {
 
         // After finding the path, draw it and display for a few seconds.
 
-        pathfinder.DrawPath();
+        area.DrawPath(pathfinder.GetPath());
         Console::SwapBuffers();
 
+        // The demo never exits, so the events are dropped once written instead of piling up
+        if (tracing) {
+            Trace::WriteChromeTrace(argv[2]);
+            Trace::Clear();
+        }
+
         Sleep(2000);
     }
 }